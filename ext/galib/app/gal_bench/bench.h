@@ -0,0 +1,141 @@
+//
+// Created on 18/10/2026.
+//
+// A small self contained microbenchmark harness: every case runs a few untimed warmup repetitions, then times each
+// repetition on its own and reports the mean, standard deviation, min, median and max, plus the time per item for
+// cases that do a batch of items per repetition.
+//
+#ifndef LCSCGA_BENCH_H
+#define LCSCGA_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace bench {
+    // Keeps the compiler from dropping a computation whose result is not used.
+    template <typename T>
+    inline void keep(const T & value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    struct Settings {
+        int warmup = 2;
+        int repetitions = 10;
+        std::string filter;     // Only run cases whose name contains this
+    };
+
+    struct Result {
+        std::string name;
+        unsigned int nodes;
+        double degree;          // Mean degree of the generated graphs
+        std::size_t items;      // Work items per repetition, e.g. chromosomes decoded
+        int repetitions;
+        double mean, stddev, min, median, max;     // Seconds per repetition
+
+        double perItem() const { return mean / static_cast<double>(std::max<std::size_t>(items, 1)); }
+    };
+
+    class Runner {
+    public:
+        explicit Runner(Settings settings) : settings(std::move(settings)) {}
+
+        bool selected(const std::string & name) const {
+            return settings.filter.empty() || name.find(settings.filter) != std::string::npos;
+        }
+
+        // Times run() after an untimed setup() before every repetition, which prepares the input run() consumes
+        // (e.g. fresh copies of chromosomes to cross over).
+        template <typename Setup, typename Run>
+        void measure(const std::string & name, unsigned int nodes, double degree, std::size_t items, Setup setup,
+                     Run run) {
+            if (!selected(name)) return;
+            for (int i = 0; i < settings.warmup; i++) {
+                auto input = setup();
+                run(input);
+            }
+            std::vector<double> seconds;
+            for (int i = 0; i < settings.repetitions; i++) {
+                auto input = setup();
+                auto start = std::chrono::steady_clock::now();
+                run(input);
+                seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+            results.push_back(summarise(name, nodes, degree, items, seconds));
+            print(results.back());
+        }
+
+        // measure() for cases without per repetition input.
+        template <typename Run>
+        void measure(const std::string & name, unsigned int nodes, double degree, std::size_t items, Run run) {
+            measure(name, nodes, degree, items, [] { return 0; }, [&](int) { run(); });
+        }
+
+        const std::vector<Result> & getResults() const { return results; }
+
+        static void printHeader() {
+            std::cout << std::left << std::setw(24) << "case" << std::right << std::setw(9) << "nodes"
+                      << std::setw(8) << "degree" << std::setw(12) << "mean ms" << std::setw(10) << "stddev"
+                      << std::setw(12) << "min ms" << std::setw(12) << "median ms" << std::setw(12) << "max ms"
+                      << std::setw(14) << "ns/item" << std::endl;
+        }
+
+        static void writeCsv(std::ostream & out, const std::vector<Result> & results) {
+            out << "case,nodes,degree,items,repetitions,mean_s,stddev_s,min_s,median_s,max_s,per_item_s\n";
+            out << std::setprecision(9);
+            for (auto & r : results) {
+                out << r.name << ',' << r.nodes << ',' << r.degree << ',' << r.items << ',' << r.repetitions << ','
+                    << r.mean << ',' << r.stddev << ',' << r.min << ',' << r.median << ',' << r.max << ','
+                    << r.perItem() << '\n';
+            }
+        }
+
+        static void writeJson(std::ostream & out, const std::vector<Result> & results) {
+            out << std::setprecision(9) << "[\n";
+            for (std::size_t i = 0; i < results.size(); i++) {
+                auto & r = results[i];
+                out << "  {\"case\":\"" << r.name << "\",\"nodes\":" << r.nodes << ",\"degree\":" << r.degree
+                    << ",\"items\":" << r.items << ",\"repetitions\":" << r.repetitions << ",\"mean_s\":" << r.mean
+                    << ",\"stddev_s\":" << r.stddev << ",\"min_s\":" << r.min << ",\"median_s\":" << r.median
+                    << ",\"max_s\":" << r.max << ",\"per_item_s\":" << r.perItem() << '}'
+                    << (i + 1 < results.size() ? ",\n" : "\n");
+            }
+            out << "]\n";
+        }
+
+    private:
+        Settings settings;
+        std::vector<Result> results;
+
+        Result summarise(const std::string & name, unsigned int nodes, double degree, std::size_t items,
+                         std::vector<double> seconds) const {
+            std::sort(seconds.begin(), seconds.end());
+            const double n = static_cast<double>(seconds.size());
+            const double mean = std::accumulate(seconds.begin(), seconds.end(), 0.0) / n;
+            double squares = 0;
+            for (auto s : seconds) squares += (s - mean) * (s - mean);
+            const std::size_t mid = seconds.size() / 2;
+            const double median = seconds.size() % 2 ? seconds[mid] : (seconds[mid - 1] + seconds[mid]) / 2;
+            return {name, nodes, degree, items, static_cast<int>(seconds.size()), mean,
+                    seconds.size() > 1 ? std::sqrt(squares / (n - 1)) : 0.0, seconds.front(), median, seconds.back()};
+        }
+
+        static void print(const Result & r) {
+            std::cout << std::left << std::setw(24) << r.name << std::right << std::setw(9) << r.nodes
+                      << std::setw(8) << std::setprecision(3) << std::defaultfloat << r.degree << std::fixed
+                      << std::setprecision(3) << std::setw(12) << r.mean * 1e3 << std::setw(9)
+                      << (r.mean > 0 ? 100 * r.stddev / r.mean : 0) << '%' << std::setw(12) << r.min * 1e3
+                      << std::setw(12) << r.median * 1e3 << std::setw(12) << r.max * 1e3 << std::setprecision(1)
+                      << std::setw(14) << r.perItem() * 1e9 << std::defaultfloat << std::endl;
+        }
+    };
+}
+
+#endif //LCSCGA_BENCH_H
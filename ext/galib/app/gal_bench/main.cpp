@@ -0,0 +1,161 @@
+//
+// Created on 18/10/2026.
+//
+// Microbenchmarks of the graph_lib and GA kernels over random graphs of several sizes and mean degrees. Configure
+// with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+//
+//   gal_bench [--sizes 1000,10000,100000] [--degrees 3,10] [--reps 10] [--warmup 2] [--filter name]
+//             [--csv file] [--json file]
+//
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "bench.h"
+#include "../longest_path_problem/longest_path_problem.hpp"
+#include "../../include/algorithm.hpp"
+#include "../../include/randomGraph.h"
+
+namespace {
+    using namespace graph_lib;
+
+    // erdosInputGen looks at every pair of nodes and crossover_optimum decodes both parents at every step, larger
+    // graphs are left out of their cases.
+    constexpr unsigned int quadraticMaxNodes = 20000;
+    constexpr std::size_t decodeBatch = 64;
+    constexpr std::size_t crossoverPairs = 32;
+    constexpr int populationSize = 100;
+
+    template <typename T>
+    std::vector<T> parseList(const std::string & text) {
+        std::vector<T> values;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            std::stringstream parse(item);
+            T value;
+            if (!(parse >> value)) throw std::invalid_argument("Could not parse '" + item + "' in '" + text + "'.");
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    std::vector<gal::PathChromosome> randomChromosomes(const Graph & graph, std::size_t count, std::mt19937 & gen,
+                                                       int crossoverType = 0) {
+        std::vector<gal::PathChromosome> chromosomes;
+        for (std::size_t i = 0; i < count; i++) chromosomes.emplace_back(graph, gen, crossoverType);
+        return chromosomes;
+    }
+
+    void graphCases(bench::Runner & runner, unsigned int nodes, double degree) {
+        const double p = nodes > 1 ? degree / (nodes - 1) : 0;
+        const auto edges = erdosInputGenSkip(nodes, p, 1, 0, 1000);
+        const Graph graph(edges, nodes);
+        std::mt19937 gen(2);
+
+        runner.measure("graph_build", nodes, degree, edges.size(), [&] { bench::keep(Graph(edges, nodes)); });
+        runner.measure("find_components", nodes, degree, edges.size(), [&] {
+            bench::keep(findConnectedComponents(edges, nodes));
+        });
+        if (nodes <= quadraticMaxNodes) {
+            runner.measure("erdos_input_gen", nodes, degree, nodes, [&] { bench::keep(erdosInputGen(nodes, p, 3)); });
+        }
+        runner.measure("erdos_input_gen_skip", nodes, degree, nodes, [&] {
+            bench::keep(erdosInputGenSkip(nodes, p, 3, 1));
+        });
+
+        runner.measure("get_random_edge", nodes, degree, nodes, [&] {
+            unsigned int sum = 0;
+            for (unsigned int v = 1; v <= nodes; v++) sum += graph.getRandomEdge(v, gen);
+            bench::keep(sum);
+        });
+
+        std::vector<std::vector<unsigned int>> genes;
+        for (auto & chromosome : randomChromosomes(graph, decodeBatch, gen)) genes.push_back(chromosome.bits_);
+        runner.measure("compute_path", nodes, degree, genes.size(), [&] {
+            for (auto & g : genes) bench::keep(graph.computePath(g));
+        });
+        runner.measure("compute_path_length", nodes, degree, genes.size(), [&] {
+            for (auto & g : genes) bench::keep(graph.computePathLength(g));
+        });
+        DecodeBuffer buffer;
+        runner.measure("compute_repaired_path", nodes, degree, genes.size(), [&] {
+            for (auto & g : genes) bench::keep(graph.computeRepairedPath(g, buffer, true));
+        });
+    }
+
+    void gaCases(bench::Runner & runner, unsigned int nodes, double degree) {
+        const Graph graph = erdosGraphConnected(nodes, nodes > 1 ? degree / (nodes - 1) : 0, 1, 0, 1000);
+        std::mt19937 gen(4);
+
+        for (int type = 0; type <= 3; type++) {
+            if (type == 2 && nodes > quadraticMaxNodes) continue;
+            const auto parents = randomChromosomes(graph, 2 * crossoverPairs, gen, type);
+            runner.measure("crossover_" + std::to_string(type), nodes, degree, crossoverPairs,
+                           [&] { return parents; }, [&](std::vector<gal::PathChromosome> & children) {
+                for (std::size_t i = 0; i < crossoverPairs; i++) children[2 * i].crossover(children[2 * i + 1]);
+            });
+        }
+
+        const auto population = randomChromosomes(graph, populationSize, gen);
+        runner.measure("mutate", nodes, degree, population.size(), [&] { return population; },
+                       [&](std::vector<gal::PathChromosome> & chromosomes) {
+            for (auto & chromosome : chromosomes) chromosome.mutate(0.05);
+        });
+
+        auto problem = gal::LongestPathProblem(graph, 5);
+        auto ga = gal::GeneticAlgorithm<gal::PathChromosome>(problem, populationSize, 0.05, 0.5, 10);
+        const auto & members = ga.population();
+        const std::vector<double> objectives(ga.objectives().begin(), ga.objectives().end());
+        auto fitness = ga.fitness(objectives);
+        double total = std::reduce(fitness.begin(), fitness.end());
+        runner.measure("select", nodes, degree, members.size(), [&] {
+            int sum = 0;
+            for (std::size_t i = 0; i < members.size(); i++) sum += ga.select(fitness, total);
+            bench::keep(sum);
+        });
+        runner.measure("reproduce", nodes, degree, members.size(), [&] {
+            bench::keep(ga.reproduce(members, objectives, 10));
+        });
+    }
+}
+
+int main(int argc, char ** argv) {
+    bench::Settings settings;
+    std::vector<unsigned int> sizes = {1000, 10000, 100000};
+    std::vector<double> degrees = {3, 10};
+    std::string csvFile, jsonFile;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) throw std::invalid_argument("Missing value for '" + arg + "'.");
+        const std::string value = argv[++i];
+        if (arg == "--sizes") sizes = parseList<unsigned int>(value);
+        else if (arg == "--degrees") degrees = parseList<double>(value);
+        else if (arg == "--reps") settings.repetitions = std::stoi(value);
+        else if (arg == "--warmup") settings.warmup = std::stoi(value);
+        else if (arg == "--filter") settings.filter = value;
+        else if (arg == "--csv") csvFile = value;
+        else if (arg == "--json") jsonFile = value;
+        else throw std::invalid_argument("Unknown option '" + arg + "'.");
+    }
+    if (settings.repetitions < 1) throw std::invalid_argument("Need at least one repetition.");
+
+    // The GA draws from the engine of its thread, a fixed seed makes every run do the same work.
+    engine.seed(1);
+    bench::Runner runner(settings);
+    bench::Runner::printHeader();
+    for (auto nodes : sizes) {
+        for (auto degree : degrees) {
+            graphCases(runner, nodes, degree);
+            gaCases(runner, nodes, degree);
+        }
+    }
+    if (!csvFile.empty()) {
+        std::ofstream out(csvFile);
+        bench::Runner::writeCsv(out, runner.getResults());
+    }
+    if (!jsonFile.empty()) {
+        std::ofstream out(jsonFile);
+        bench::Runner::writeJson(out, runner.getResults());
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+//
+// Created on 18/10/2026.
+//
+// Streams a benchmark graph with a known longest path to stdout, without holding it in memory:
+//
+//   generate_graph <type 9-13> <nodes> <mean degree> <seed> > graph.txt
+//
+// The first line is a comment with the optimum, then the node count and an "u v w" line per edge.
+//
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../include/benchmarkGraphs.h"
+
+int main(int argc, char ** argv) {
+    if (argc != 5) {
+        std::cerr << "usage: " << argv[0] << " <type 9-13> <nodes> <mean degree> <seed>" << std::endl;
+        return 1;
+    }
+    const int type = std::stoi(argv[1]);
+    const auto nodes = static_cast<unsigned int>(std::stoul(argv[2]));
+    if (!graph_lib::isBenchmarkGraphType(type)) throw std::invalid_argument("Type has to be one of 9 to 13.");
+    std::ios::sync_with_stdio(false);
+    std::cout << "# optimum " << *graph_lib::knownOptimum(type, nodes) << '\n';
+    graph_lib::writeEdgeListHeader(std::cout, nodes);
+    graph_lib::benchmarkGraphEdges(type, nodes, std::stod(argv[3]), std::stoi(argv[4]),
+                                   graph_lib::edgeListWriter(std::cout));
+    return 0;
+}
@@ -6,41 +6,109 @@
  * @author Arthur van Dam, dam@math.uu.nl
  * @author Adriaan Graas, a.b.m.graas@uu.nl
  */
+#pragma once
+
 #include "../../include/problem.hpp"
 #include "path_chromosome.hpp"
 #include "../../include/graph.h"
+#include "../../include/seeding.h"
 
 namespace gal {
 
-    class LongestPathProblem : public Problem<PathChromosome> {
+    /**
+     * Version of what a GA run on this problem returns for a given graph, configuration and seed. Bump it with every
+     * change to the GA, the problem or the chromosome that alters results, so cached results are recomputed.
+     */
+    constexpr std::uint32_t longestPathVersion = 1;
+
+    /**
+     * Longest path problem on a graph of type G, e.g. graph_lib::CompactGraph for huge graphs or
+     * graph_lib::RealGraph for real valued weights.
+     */
+    template <typename G = graph_lib::Graph>
+    class BasicLongestPathProblem : public Problem<BasicPathChromosome<G>> {
     public:
-        explicit LongestPathProblem(graph_lib::Graph graph, int seed, int crossType = 0, bool localSearch = false)
-            : graph_(graph)
+        using PathChromosome = BasicPathChromosome<G>;
+
+        /**
+         * @param seedFraction Fraction of every population built from heuristic paths (see graph_lib::seedPath)
+         *        instead of random preferences.
+         * @param decoder How chromosomes decode to paths, see graph_lib::PathDecoder.
+         */
+        explicit BasicLongestPathProblem(G graph, int seed, int crossType = 0, bool localSearch = false,
+                                         double seedFraction = 0,
+                                         graph_lib::PathDecoder decoder = graph_lib::PathDecoder::Stop)
+            : graph_(std::move(graph)), // Graphs share their adjacency arrays, so this copy is cheap.
+              decoder_(decoder)
         {
-            chromosome_length_ = graph_.getNodeCount() + 1;
+            if (seedFraction < 0.0 || seedFraction > 1.0)
+                throw std::invalid_argument("Seed fraction has to be in [0.0, 1.0].");
+            seed_fraction_ = seedFraction;
+            this->chromosome_length_ = graph_.getNodeCount() + 1;
             gen_ = std::mt19937(seed);
             crossover_type_ = crossType;
-            local_search_ = localSearch;
+            this->local_search_ = localSearch;
         }
 
         /**
          * Constructs a new PathChromosome.
          */
         PathChromosome createChromosome() override {
-            return PathChromosome(graph_, gen_, crossover_type_);
+            // Seeded chromosomes are handed out whenever they fall behind seed_fraction_ of all chromosomes so far, so
+            // any population gets its share. They are built in parallel, a batch at a time.
+            created_++;
+            if (static_cast<double>(seeded_) < seed_fraction_ * static_cast<double>(created_)) {
+                if (seeds_.empty()) seeds_ = graph_lib::seedChromosomes(graph_, seed_batch_, gen_(), seed_threads_);
+                seeded_++;
+                auto genes = std::move(seeds_.back());
+                seeds_.pop_back();
+                return PathChromosome(graph_, gen_, crossover_type_, std::move(genes), decoder_);
+            }
+            return PathChromosome(graph_, gen_, crossover_type_, decoder_);
+        }
+
+        /**
+         * Sets the number of threads seeded chromosomes are built with, 0 (the default) for all cores.
+         */
+        void setSeedThreads(unsigned int threads) {
+            seed_threads_ = threads;
         }
 
         /**
          * Evaluates the objective function for an input value.
          */
         double evaluate(const PathChromosome chromo) const override {
-            return chromo.getValue();
+            return static_cast<double>(chromo.getPathLength());
+
+        }
+
+        /**
+         * The state of gen_, which chromosomes draw their mutations from. Seeded chromosomes still waiting to be
+         * handed out are not part of it, they are only used while the first population is built.
+         */
+        std::string randomState() const override {
+            std::ostringstream state;
+            state << gen_;
+            return state.str();
+        }
 
+        void setRandomState(const std::string & state) override {
+            std::istringstream in(state);
+            in >> gen_;
         }
 
         std::mt19937 gen_;
     protected:
-        graph_lib::Graph graph_;
+        G graph_;
         int crossover_type_;
+        graph_lib::PathDecoder decoder_;
+        double seed_fraction_;
+        static constexpr std::size_t seed_batch_ = 64;
+        std::vector<std::vector<unsigned int>> seeds_;
+        std::size_t created_ = 0;
+        std::size_t seeded_ = 0;
+        unsigned int seed_threads_ = 0;
     };
+
+    using LongestPathProblem = BasicLongestPathProblem<>;
 }
\ No newline at end of file
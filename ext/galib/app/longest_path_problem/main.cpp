@@ -1,49 +1,174 @@
 #include <filesystem>
+#include <functional>
+#include <optional>
 #include "main.h"
 #include "longest_path_problem.hpp"
 #include "../../include/algorithm.hpp"
 #include "../../include/testGraphs.h"
+#include "../../include/graphSnapshot.h"
+#include "../../include/exactSolver.h"
+#include "../../include/branchAndBound.h"
+#include "../../include/structuredSolver.h"
+#include "../../include/reduction.h"
+#include "../../include/relabel.h"
+#include "../../include/resultCache.h"
 using namespace gal;
 
-int main(){
-    RunParameters cfg = read_parameter_file();
-    int seed = cfg.random_seed != 0 ? cfg.random_seed : std::mt19937 (std::random_device{}())();
-
-    auto graph = graph_lib::getGraphByType(cfg.graph_type, cfg.graph_nodes, cfg.graph_p, seed);
-    if (cfg.graph_override_ones) graph.oneify();
-
-    auto problem = LongestPathProblem(graph, seed, cfg.crossover_type, cfg.local_search);
+/**
+ * Runs the GA on gaGraph, searchGraph or a copy of it with another weight type, followed by branch and bound on
+ * searchGraph when bnb_time_limit is set. Paths are also printed in original ids through expand when renumbered.
+ */
+template <typename G>
+void runGA(const G & gaGraph, const graph_lib::Graph & searchGraph, const RunParameters & cfg, int seed,
+           bool renumbered, const std::function<graph_lib::PathSolution(const graph_lib::PathSolution &)> & expand) {
+    using Chromosome = BasicPathChromosome<G>;
+    using Gene = typename GeneticAlgorithm<Chromosome>::Gene;
+    auto problem = BasicLongestPathProblem<G>(gaGraph, seed, cfg.crossover_type, cfg.local_search,
+                                              cfg.seed_fraction, graph_lib::parsePathDecoder(cfg.decoder));
 
-    auto ga = GeneticAlgorithm<PathChromosome>(
+    auto ga = GeneticAlgorithm<Chromosome>(
             problem,
             cfg.population_size,
             cfg.mutation_probability,
             cfg.crossover_probability,
             cfg.nr_of_elites);
 
+    std::ofstream statsFile;
+    if (!cfg.stats_file.empty()) {
+#ifdef GAL_INSTRUMENT
+        statsFile.open(cfg.stats_file);
+        ga.setStatsSink(cfg.stats_file.ends_with(".json") ? jsonSink(statsFile) : csvSink(statsFile));
+#else
+        std::cout << "Ignoring stats_file, generation statistics need a build with -DGAL_INSTRUMENT=ON" << std::endl;
+#endif
+    }
+    if (cfg.perf_counters) {
+#ifdef GAL_INSTRUMENT
+        if (!ga.enableHardwareCounters()) {
+            std::cout << "No hardware counters: " << graph_lib::PerfCounters().reason() << std::endl;
+        }
+#else
+        std::cout << "Ignoring perf_counters, per phase counts need a build with -DGAL_INSTRUMENT=ON" << std::endl;
+#endif
+    }
 
-    // run genetic algorithm until `nr_generations` or convergence criteria
-    while (true) {
-        ga.nextGeneration();
-        std::cout << std::endl << "Generation: " << ga.generation() << std::endl;
+    // A checkpoint only fits the same search graph and the parameters that shape the population, the generation and
+    // convergence limits may change between runs to continue a finished one.
+    const auto fingerprint = graph_lib::KeyHasher().add(graph_lib::adjacencyChecksum(searchGraph))
+            .add(cfg.population_size).add(cfg.crossover_type).add(cfg.local_search).add(cfg.seed_fraction)
+            .add(cfg.decoder).value();
+    std::optional<CheckpointWriter<Gene>> checkpoints;
+    if (!cfg.checkpoint_file.empty()) {
+        if (cfg.checkpoint_interval <= 0) throw std::invalid_argument("checkpoint_interval must be positive.");
+        if (std::filesystem::exists(cfg.checkpoint_file)) {
+            ga.restore(readCheckpoint<Gene>(cfg.checkpoint_file), fingerprint);
+            std::cout << "Resuming from " << cfg.checkpoint_file << " at generation " << ga.generation() << std::endl;
+        }
+        checkpoints.emplace(cfg.checkpoint_file);
+    }
 
-        auto popu = ga.population(); // vector of PathChromosome
-        auto iter = popu.begin(); // an iterator of this vector
-        for (int i = 0; i < 5; i++) {
-            std::cout << iter->getValue() << " : " << iter->getText() << std::endl;
-            iter++;
+    // Printing chromosomes decodes them again, so that only happens every print_interval generations and at the end.
+    auto printPopulation = [&] {
+        auto objectives = ga.objectives();
+        auto first = ga.population(5);
+        for (std::size_t i = 0; i < first.size(); i++) {
+            std::cout << static_cast<unsigned int>(objectives[i]) << " : " << first[i].getText() << std::endl;
         }
 
-        std::cout << " * Objective value: " << ga.objectiveValues().back() << std::endl;
         std::cout << " * Optimum solution: " << ga.optimum().getText() << std::endl;
+        if (renumbered)
+            std::cout << " * Solution in original ids: " << expand(ga.optimum().getPath()).getText() << std::endl;
+    };
+    auto printed = [&](int generation) { return cfg.print_interval > 0 && generation % cfg.print_interval == 0; };
+    // The summary of each generation comes from its snapshot, which needs no decoding.
+    ga.setObserver([&](const GenerationSnapshot & snapshot) {
+        std::cout << std::endl << "Generation: " << snapshot.generation << std::endl;
+        std::cout << " * Objective value: " << snapshot.best << std::endl;
+        std::cout << " * Mean objective: " << snapshot.mean << ", diversity: " << snapshot.diversity << std::endl;
+        if (printed(snapshot.generation)) printPopulation();
+    });
+
+    // run genetic algorithm until `nr_generations` or convergence criteria
+    while (true) {
+        ga.nextGeneration();
+        if (checkpoints && ga.generation() % cfg.checkpoint_interval == 0)
+            checkpoints->write(ga.checkpoint(fingerprint));
 
         if (ga.hasConverged(cfg.convergence_threshold)
             || ga.generation() >= cfg.nr_generations) {
+            if (!printed(ga.generation())) printPopulation();
             std::cout << "Generation " << ga.generation() << " converged." << std::endl;
+            if (checkpoints) checkpoints->write(ga.checkpoint(fingerprint));
             break;
         }
     }
 
+    // Starting from the GA's answer, search for a better path or a proof that there is none.
+    if (cfg.bnb_time_limit > 0) {
+        graph_lib::BranchAndBoundOptions options;
+        options.timeLimit = std::chrono::milliseconds(static_cast<long long>(cfg.bnb_time_limit * 1000));
+        options.report = [](const graph_lib::BranchAndBoundProgress & progress) {
+            std::cout << "Branch and bound: " << progress.seconds << "s, incumbent " << progress.incumbent
+                      << ", bound " << progress.bound << ", gap " << progress.getGap() << std::endl;
+        };
+        auto result = graph_lib::longestPathBranchAndBound(searchGraph, ga.optimum().getPath(), options);
+        std::cout << " * " << (result.optimal ? "Optimal" : "Best known") << " solution: "
+                  << expand(result.best).getText() << std::endl;
+    }
+}
+
+int main(int argc, char ** argv){
+    // Parameters come from default.ini, and then from the file given on the command line, e.g. exact.ini.
+    RunParameters cfg = read_parameter_file();
+    if (argc > 1) cfg = read_parameter_file(argv[1], cfg);
+    int seed = cfg.random_seed != 0 ? cfg.random_seed : std::mt19937 (std::random_device{}())();
+
+    auto graph = graph_lib::getGraphByTypeCached(cfg.graph_type, cfg.graph_nodes, cfg.graph_p, seed,
+                                                  cfg.graph_snapshot_dir);
+    if (cfg.graph_override_ones) graph.oneify();
+
+    // Trees, cycles and graphs of small blocks are solved exactly, in linear time apart from a subset DP per block that
+    // is not a cycle, bounded by blockDpBudget (see longestPathBlockTree).
+    if (auto structured = cfg.structured_solve ? graph_lib::longestPathStructured(graph) : std::nullopt) {
+        std::cout << " * Objective value: " << structured->length << std::endl;
+        std::cout << " * Exact solution: " << structured->getText() << std::endl;
+        return 0;
+    }
+
+    // Everything after this searches the reduced and renumbered graph, every path found is mapped back before printing.
+    std::optional<graph_lib::Reduction> reduction;
+    if (cfg.graph_reduce) {
+        reduction = graph_lib::reduceGraph(graph);
+        std::cout << " * Reduced graph: " << graph.getNodeCount() << " -> " << reduction->graph.getNodeCount()
+                  << " nodes" << std::endl;
+    }
+    const auto & reducedGraph = reduction ? reduction->graph : graph;
+    std::optional<graph_lib::Relabeling> relabeling;
+    auto order = graph_lib::parseNodeOrder(cfg.graph_order);
+    if (order != graph_lib::NodeOrder::Original) relabeling = graph_lib::relabelGraph(reducedGraph, order);
+    const auto & searchGraph = relabeling ? relabeling->graph : reducedGraph;
+    auto expand = [&](const graph_lib::PathSolution & path) {
+        auto restored = relabeling ? relabeling->restore(path) : path;
+        return reduction ? reduction->expand(restored) : restored;
+    };
+
+    // Tiny graphs are solved exactly in less time than a single generation takes.
+    if (cfg.exact_max_nodes > 0 && searchGraph.getNodeCount() <= cfg.exact_max_nodes) {
+        auto solution = expand(graph_lib::longestPathDp(searchGraph));
+        std::cout << " * Objective value: " << solution.length << std::endl;
+        std::cout << " * Exact solution: " << solution.getText() << std::endl;
+        return 0;
+    }
+
+    // CompactGraph halves the weight array the decoder walks, the solvers around the GA keep using searchGraph.
+    auto weightType = graph_lib::parseWeightType(cfg.graph_weight_type);
+    if (weightType == graph_lib::WeightType::Compact
+        || (weightType == graph_lib::WeightType::Auto && graph_lib::weightsFit<std::uint16_t>(searchGraph))) {
+        std::cout << " * Searching a CompactGraph" << std::endl;
+        runGA(graph_lib::CompactGraph(searchGraph), searchGraph, cfg, seed, reduction || relabeling, expand);
+    } else {
+        runGA(searchGraph, searchGraph, cfg, seed, reduction || relabeling, expand);
+    }
     return 0;
 };
 
@@ -60,13 +185,80 @@ std::string_view trim(std::string_view s) {
     return s;
 }
 
+/**
+ * Sets the parameter called key, as in the parameter file, to value.
+ */
+void set_parameter(RunParameters &config, const std::string &key, const std::string &value) {
+    if (key == "graph_type") {
+        config.graph_type = std::stoi(value);
+    } else if (key == "graph_nodes") {
+        config.graph_nodes = std::stoi(value);
+    } else if (key == "graph_p") {
+        config.graph_p = std::stod(value);
+    } else if (key == "graph_snapshot_dir") {
+        config.graph_snapshot_dir = value;
+    } else if (key == "random_seed") {
+        config.random_seed = std::stoi(value);
+    } else if (key == "graph_override_ones") {
+        config.graph_override_ones = value == "true";
+    } else if (key == "graph_reduce") {
+        config.graph_reduce = value == "true";
+    } else if (key == "graph_order") {
+        config.graph_order = value;
+    } else if (key == "nr_generations") {
+        config.nr_generations = std::stoi(value);
+    } else if (key == "population_size") {
+        config.population_size = std::stoi(value);
+    } else if (key == "chromosome_length") {
+        config.chromosome_length = std::stoi(value);
+    } else if (key == "mutation_probability") {
+        config.mutation_probability = std::stod(value);
+    } else if (key == "crossover_probability") {
+        config.crossover_probability = std::stod(value);
+    } else if (key == "convergence_threshold") {
+        config.convergence_threshold = std::stoi(value);
+    } else if (key == "nr_of_elites") {
+        config.nr_of_elites = std::stoi(value);
+    } else if (key == "crossover_type") {
+        config.crossover_type = std::stoi(value);
+    } else if (key == "local_search") {
+        config.local_search = value == "true";
+    } else if (key == "seed_fraction") {
+        config.seed_fraction = std::stod(value);
+    } else if (key == "decoder") {
+        config.decoder = value;
+    } else if (key == "exact_max_nodes") {
+        config.exact_max_nodes = std::stoul(value);
+    } else if (key == "structured_solve") {
+        config.structured_solve = value == "true";
+    } else if (key == "bnb_time_limit") {
+        config.bnb_time_limit = std::stod(value);
+    } else if (key == "stats_file") {
+        config.stats_file = value;
+    } else if (key == "perf_counters") {
+        config.perf_counters = value == "true";
+    } else if (key == "result_cache_dir") {
+        config.result_cache_dir = value;
+    } else if (key == "checkpoint_file") {
+        config.checkpoint_file = value;
+    } else if (key == "checkpoint_interval") {
+        config.checkpoint_interval = std::stoi(value);
+    } else if (key == "print_interval") {
+        config.print_interval = std::stoi(value);
+    } else if (key == "graph_weight_type") {
+        config.graph_weight_type = value;
+    } else {
+        throw std::runtime_error("Could not parse unknown parameter with key '" + key + "'.");
+    }
+}
+
 /**
  * Read a parameter file.
  *
  * @param filename
  * @return
  */
-RunParameters read_parameter_file(const std::string &filename) {
+RunParameters read_parameter_file(const std::string &filename, RunParameters config) {
     if (!std::filesystem::exists(filename)) {
         throw std::invalid_argument(
                 "Input file " + filename
@@ -78,7 +270,6 @@ RunParameters read_parameter_file(const std::string &filename) {
 
     std::ifstream file;
     file.open(filename);
-    auto config = RunParameters();
 
     std::string line;
     while (std::getline(file, line)) {
@@ -89,37 +280,7 @@ RunParameters read_parameter_file(const std::string &filename) {
             key = trim(key);
             if (std::getline(in_line, value)) {
                 value = trim(value);
-                if (key == "graph_type") {
-                    config.graph_type = std::stoi(value);
-                } else if (key == "graph_nodes") {
-                    config.graph_nodes = std::stoi(value);
-                } else if (key == "graph_p") {
-                    config.graph_p = std::stod(value);
-                } else if (key == "random_seed") {
-                    config.random_seed = std::stoi(value);
-                } else if (key == "graph_override_ones") {
-                    config.graph_override_ones = value == "true";
-                } else if (key == "nr_generations") {
-                    config.nr_generations = std::stoi(value);
-                } else if (key == "population_size") {
-                    config.population_size = std::stoi(value);
-                } else if (key == "chromosome_length") {
-                    config.chromosome_length = std::stoi(value);
-                } else if (key == "mutation_probability") {
-                    config.mutation_probability = std::stod(value);
-                } else if (key == "crossover_probability") {
-                    config.crossover_probability = std::stod(value);
-                } else if (key == "convergence_threshold") {
-                    config.convergence_threshold = std::stoi(value);
-                } else if (key == "nr_of_elites") {
-                    config.nr_of_elites = std::stoi(value);
-                } else if (key == "crossover_type") {
-                    config.crossover_type = std::stoi(value);
-                } else if (key == "local_search") {
-                    config.local_search = value == "true";
-                } else {
-                    throw std::runtime_error("Could not parse unknown parameter with key '" + key + "'.");
-                }
+                set_parameter(config, key, value);
             }
         }
     }
@@ -12,6 +12,8 @@
 #include <fstream>
 #include <cstring>
 #include <cstdio>
+#include <string>
+#include <string_view>
 
 /**
  * A struct with all necessary parameters to initialize an optimisation
@@ -23,6 +25,10 @@ struct RunParameters {
     int graph_nodes;
     double graph_p;
     bool graph_override_ones;
+    std::string graph_snapshot_dir;  // Directory to cache generated graphs in as snapshots, empty to disable
+    bool graph_reduce;             // Run the GA on the graph with pendant trees and degree 2 chains contracted
+    std::string graph_order;       // Node renumbering before the search for cache locality: none, bfs, rcm or degree
+    std::string graph_weight_type; // Weights the GA decodes with: int, compact (16 bit) or auto (compact if they fit)
     int random_seed;
     int nr_generations;            // Nr of generations
     int population_size;           // Nr of strings per generation
@@ -33,9 +39,32 @@ struct RunParameters {
     int nr_of_elites;              // Nr of elites per generation
     int crossover_type;
     bool local_search;
+    double seed_fraction;          // Fraction of the initial population built from greedy, DFS and Warnsdorff paths
+    std::string decoder;           // stop (at the first dead end), repair (try other neighbours) or both (+ backward)
+    unsigned int exact_max_nodes;  // Graphs up to this many nodes are solved exactly instead of by the GA, 0 = off
+    bool structured_solve;         // Trees, cycles and graphs of small blocks are solved exactly instead of by the GA
+    double bnb_time_limit;         // Seconds of branch and bound after the GA to prove or bound its result, 0 = off
+    std::string stats_file;        // Per generation phase timings and counters, CSV or JSON (.json), empty = off
+    bool perf_counters;            // Read cycles, instructions, cache and branch misses per phase and per run
+    std::string result_cache_dir;  // Directory to cache experiment runs in, by graph, parameters and seed, empty = off
+    std::string checkpoint_file;   // GA state is saved here and a run resumes from it if it exists, empty = off
+    int checkpoint_interval;       // Nr of generations between checkpoints
+    int print_interval;            // Nr of generations between printing chromosomes, 0 = only after the last one
 };
 
 /**
- * Reads parameters from a file.
+ * Removes whitespace at the beginning and end of a string.
  */
-RunParameters read_parameter_file(const std::string &filename = "../app/longest_path_problem/default.ini");
\ No newline at end of file
+std::string_view trim(std::string_view s);
+
+/**
+ * Sets the parameter called key, as in the parameter file, to value. Throws on unknown keys.
+ */
+void set_parameter(RunParameters &config, const std::string &key, const std::string &value);
+
+/**
+ * Reads parameters from a file. Keys the file leaves out keep their value in config, so a small file can change a few
+ * parameters of default.ini.
+ */
+RunParameters read_parameter_file(const std::string &filename = "../app/longest_path_problem/default.ini",
+                                  RunParameters config = RunParameters());
\ No newline at end of file
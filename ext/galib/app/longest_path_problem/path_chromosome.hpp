@@ -12,6 +12,7 @@
 #include <string>
 #include <sstream>
 #include "../../include/graph.h"
+#include "../../include/exactSolver.h"
 #include "../../include/util.hpp"
 #include "../../include/chromosome.hpp"
 
@@ -20,15 +21,22 @@ namespace gal {
      * class IntegerChromosome implements a BitstringChromosome<int> that represents
      * a path. Bitstring is interpreted as a reversed binary
      * number.
+     *
+     * @tparam G The graph type, whose Length the path lengths are computed in.
      */
-    class PathChromosome : public Chromosome<unsigned int>{
+    template <typename G = graph_lib::Graph>
+    class BasicPathChromosome : public Chromosome<unsigned int>{
     public:
+        using Length = typename G::Length;
+
         /**
          * Constructs a new PathChromosome and initialises it randomly.
          * Do not set the length too large (<=32 generally)
          * @param length Length of the bitstring.
          */
-        PathChromosome(const graph_lib::Graph & graph, std::mt19937 & gen, int crossover_type) : graph_ref_(graph), gen_(gen) {
+        BasicPathChromosome(const G & graph, std::mt19937 & gen, int crossover_type,
+                            graph_lib::PathDecoder decoder = graph_lib::PathDecoder::Stop)
+            : graph_ref_(graph), gen_(gen), decoder_(decoder) {
             // Generate a random bits_ to set a random path
             bits_ = std::vector<unsigned int>(graph.getNodeCount()+1);
             bits_[0] = (gen() % graph.getNodeCount()) + 1; // 1-indexed nodes.
@@ -40,14 +48,35 @@ namespace gal {
             crossover_type_ = crossover_type;
         }
 
+        /**
+         * Constructs a PathChromosome with the given preferences, e.g. from graph_lib::encodePath.
+         */
+        BasicPathChromosome(const G & graph, std::mt19937 & gen, int crossover_type, std::vector<unsigned int> genes,
+                            graph_lib::PathDecoder decoder = graph_lib::PathDecoder::Stop)
+            : graph_ref_(graph), gen_(gen), decoder_(decoder) {
+            bits_ = std::move(genes);
+            elite_ = false;
+            crossover_type_ = crossover_type;
+        }
+
         /**
          * Returns path length
          */
-        int getPathLength() const {
-            return graph_ref_.computePath(bits_)[0];
+        Length getPathLength() const {
+            return decodeLength(bits_);
         }
 
-        virtual unsigned int getValue() const  override{ return getPathLength(); }
+        /**
+         * Returns the path length narrowed to unsigned int, exact for graph_lib::Graph. Use getPathLength otherwise.
+         */
+        virtual unsigned int getValue() const  override{ return static_cast<unsigned int>(getPathLength()); }
+
+        /**
+         * Returns the decoded path, e.g. to seed an exact solver with.
+         */
+        graph_lib::PathSolution getPath() const requires std::is_integral_v<Length> {
+            return {static_cast<std::uint64_t>(getPathLength()), decodePath(bits_)};
+        }
 
 
         virtual std::string getText() const override {
@@ -57,10 +86,10 @@ namespace gal {
                 str += std::to_string(bits_[i]);
             }
             str += ") - [";
-            auto path = graph_ref_.computePath(bits_);
-            str += std::to_string(path[0]) + " | ";
-            for (int i = 1; i < path.size(); i++){
-                if (i != 1) str += ", ";
+            auto path = decodePath(bits_);
+            str += std::to_string(getPathLength()) + " | ";
+            for (int i = 0; i < path.size(); i++){
+                if (i != 0) str += ", ";
                 str += std::to_string(path[i]);
             }
             return str + "]";
@@ -77,12 +106,12 @@ namespace gal {
 
             for(unsigned int i = 0; i < bits_.size(); i++){
                 // Generate a random double in [0.0, 1.0]
-                double mutation_roll = static_cast <double> (rand()) / (static_cast <double> (RAND_MAX));
+                double mutation_roll = random_real();
                 // Determine if we mutate this bit
                 if(mutation_roll <= probability){
                     // Randomly reassign the pref[i]. Reroll randomly untill it is different.
                     auto old_pref = bits_[i];
-                    if (graph_ref_.getNodeEdgeSet(i).size() > 1)
+                    if (graph_ref_.getDegree(i) > 1)
                     while (old_pref == bits_[i]) {
                         bits_[i] = changeBit(i);
                     }
@@ -115,7 +144,7 @@ namespace gal {
             // Result into very different paths, but will never be worse than the best of the two chromosomes.
             // All the bits that are part of the path will become the same.
             while (!visited[current]){
-                if (graph_ref_.computePath(bits_)[0] > graph_ref_.computePath(chromosome.bits_)[0]){
+                if (decodeLength(bits_) > decodeLength(chromosome.bits_)){
                     chromosome.bits_[current] = bits_[current];
                 } else {
                     bits_[current] = chromosome.bits_[current];
@@ -162,13 +191,13 @@ namespace gal {
         void localSearch() override{
             unsigned int bestUpgradeIndex = 0;
             unsigned int bestUpgradeParam = 0;
-            unsigned int bestLength = 0;
+            Length bestLength = 0;
             auto testBits_ = std::vector<unsigned int>(bits_);
             // Copy the preferences, then loop over each of the indices in the bits, and change *only that bit* to each
             // possible value, track whichever change has the best result globally, then make only that bit change.
             for (int i = 1; i < bits_.size(); i++){
                 testBits_[0] = i;
-                auto pathL = graph_ref_.computePath(testBits_)[0];
+                auto pathL = decodeLength(testBits_);
                 if (pathL > bestLength)
                 {
                     bestLength = pathL;
@@ -178,13 +207,13 @@ namespace gal {
             for (int i = 1; i < bits_.size(); i++){
                 //Reset the previous bit that we handled to the original value.
                 testBits_[i - 1] = bits_[i - 1];
-                for (auto edge : graph_ref_.getNodeEdgeSet(i)){
-                    testBits_[i] = edge.first;
-                    auto pathL = graph_ref_.computePath(testBits_)[0];
+                for (auto neighbour : graph_ref_.getNeighbours(i)){
+                    testBits_[i] = neighbour;
+                    auto pathL = decodeLength(testBits_);
                     if (pathL > bestLength)
                     {
                         bestUpgradeIndex = i;
-                        bestUpgradeParam = edge.first;
+                        bestUpgradeParam = neighbour;
                         bestLength = pathL;
                     }
                 }
@@ -197,10 +226,42 @@ namespace gal {
         }
 
     protected:
-        const graph_lib::Graph & graph_ref_;
+        const G & graph_ref_;
         std::mt19937 & gen_;
         int crossover_type_;
+        graph_lib::PathDecoder decoder_;
+
+        /**
+         * Decode scratch space, one per thread so that decoding allocates nothing.
+         */
+        static graph_lib::DecodeBuffer & decodeBuffer() {
+            thread_local graph_lib::DecodeBuffer buffer;
+            return buffer;
+        }
+
+        /**
+         * Length of the path genes decode to with this chromosome's decoder.
+         */
+        Length decodeLength(const std::vector<unsigned int> & genes) const {
+            if (decoder_ == graph_lib::PathDecoder::Stop) return graph_ref_.computePathLength(genes);
+            return graph_ref_.computeRepairedPath(genes, decodeBuffer(),
+                                                  decoder_ == graph_lib::PathDecoder::RepairBothWays);
+        }
+
+        /**
+         * Nodes of the path genes decode to with this chromosome's decoder.
+         */
+        std::vector<unsigned int> decodePath(const std::vector<unsigned int> & genes) const {
+            if (decoder_ == graph_lib::PathDecoder::Stop) {
+                auto path = graph_ref_.computePath(genes);
+                return {path.begin() + 1, path.end()};
+            }
+            decodeLength(genes);
+            return decodeBuffer().path;
+        }
         // An array containing the exit node for each node in the graph
         // Its first entry contains the start node
     };
+
+    using PathChromosome = BasicPathChromosome<>;
 }
\ No newline at end of file
@@ -1,38 +1,129 @@
 #include <filesystem>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
 #include "main.h"
 #include "longest_path_problem.hpp"
 #include "../../include/algorithm.hpp"
 #include "../../include/testGraphs.h"
+#include "../../include/graphSnapshot.h"
+#include "../../include/exactSolver.h"
+#include "../../include/structuredSolver.h"
+#include "../../include/reduction.h"
+#include "../../include/relabel.h"
+#include "../../include/perfCounters.h"
+#include "../../include/benchmarkGraphs.h"
+#include "../../include/threadPool.h"
+#include "../../include/resultCache.h"
 
 using namespace gal;
 
-std::pair<double, double> runGA(int runs, gal::LongestPathProblem::Problem & problem, RunParameters & cfg){
+/**
+ * Seed of run number index of a sweep or race, derived from the seed of the whole experiment.
+ */
+std::uint32_t derived_seed(std::uint64_t seed, std::uint64_t index) {
+    std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                      static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32)};
+    std::mt19937 gen(seq);
+    return static_cast<std::uint32_t>(gen());
+}
+
+struct SeededRun {
+    std::uint32_t seed;
+    int generations;
+    double objective;
+    double seconds;
+    std::vector<double> trace;  // Best objective of every generation
+};
+
+/**
+ * A GA run on the calling thread whose random numbers all derive from seed, so it can run next to others. Seeded
+ * chromosomes are built with seedThreads threads, which does not change the result. The graph is searched as a
+ * CompactGraph when cfg.graph_weight_type asks for it, which does not change the result either.
+ */
+template <typename G>
+SeededRun run_seeded_ga(const G &graph, const RunParameters &cfg, std::uint32_t seed, unsigned int seedThreads) {
+    engine.seed(seed);
+    auto start = std::chrono::steady_clock::now();
+    auto problem = BasicLongestPathProblem<G>(graph, static_cast<int>(seed), cfg.crossover_type, cfg.local_search,
+                                              cfg.seed_fraction, graph_lib::parsePathDecoder(cfg.decoder));
+    problem.setSeedThreads(seedThreads);
+    auto ga = GeneticAlgorithm<BasicPathChromosome<G>>(problem, cfg.population_size, cfg.mutation_probability,
+                                                       cfg.crossover_probability, cfg.nr_of_elites);
+    do {
+        ga.nextGeneration();
+    } while (!ga.hasConverged(cfg.convergence_threshold) && ga.generation() < cfg.nr_generations);
+    return {seed, ga.generation(), ga.objectiveValues().back(),
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), ga.objectiveValues()};
+}
+
+SeededRun run_seeded_ga(const graph_lib::Graph &graph, const RunParameters &cfg, std::uint32_t seed,
+                        unsigned int seedThreads = 1) {
+    auto weightType = graph_lib::parseWeightType(cfg.graph_weight_type);
+    if (weightType == graph_lib::WeightType::Compact
+        || (weightType == graph_lib::WeightType::Auto && graph_lib::weightsFit<std::uint16_t>(graph)))
+        return run_seeded_ga(graph_lib::CompactGraph(graph), cfg, seed, seedThreads);
+    return run_seeded_ga<graph_lib::Graph>(graph, cfg, seed, seedThreads);
+}
+
+/**
+ * Cache key of run_seeded_ga: the graph's adjacency, the seed and all parameters but the output and cache locations.
+ * New fields of RunParameters belong here too.
+ */
+std::uint64_t run_key(const graph_lib::Graph &graph, const RunParameters &cfg, std::uint32_t seed) {
+    graph_lib::KeyHasher key;
+    key.add(graph_lib::adjacencyChecksum(graph)).add(seed);
+    key.add(cfg.graph_type).add(cfg.graph_nodes).add(cfg.graph_p).add(cfg.graph_override_ones).add(cfg.graph_reduce)
+       .add(cfg.graph_order).add(cfg.graph_weight_type).add(cfg.random_seed);
+    key.add(cfg.nr_generations).add(cfg.population_size).add(cfg.chromosome_length).add(cfg.mutation_probability)
+       .add(cfg.crossover_probability).add(cfg.convergence_threshold).add(cfg.nr_of_elites).add(cfg.crossover_type)
+       .add(cfg.local_search).add(cfg.seed_fraction).add(cfg.decoder);
+    key.add(cfg.exact_max_nodes).add(cfg.structured_solve).add(cfg.bnb_time_limit);
+    return key.value();
+}
+
+/**
+ * run_seeded_ga, unless cache holds its result from an earlier run. The seconds are then those of that run.
+ */
+SeededRun run_cached_ga(const graph_lib::ResultCache &cache, const graph_lib::Graph &graph, const RunParameters &cfg,
+                        std::uint32_t seed, unsigned int seedThreads = 1) {
+    const auto key = cache.enabled() ? run_key(graph, cfg, seed) : 0;
+    if (auto values = cache.load(key); values && values->size() >= 4) {
+        return {static_cast<std::uint32_t>((*values)[0]), static_cast<int>((*values)[1]), (*values)[2], (*values)[3],
+                {values->begin() + 4, values->end()}};
+    }
+    auto run = run_seeded_ga(graph, cfg, seed, seedThreads);
+    if (cache.enabled()) {
+        std::vector<double> values = {static_cast<double>(run.seed), static_cast<double>(run.generations),
+                                      run.objective, run.seconds};
+        values.insert(values.end(), run.trace.begin(), run.trace.end());
+        cache.store(key, values);
+    }
+    return run;
+}
+
+
+/**
+ * Averages the generations and objective values of runs GA runs, run i seeded with derived_seed(seed, i). Objectives
+ * below atLeast count as atLeast, e.g. for the paths a graph reduction keeps aside.
+ */
+std::pair<double, double> runGA(int runs, const graph_lib::Graph & graph, RunParameters & cfg, int seed,
+                                double atLeast = 0){
+    graph_lib::ResultCache cache(cfg.result_cache_dir, longestPathVersion);
     double avg_generation = 0;
     double avg_objective = 0;
     for (int i = 0; i < runs; i++) {
-        auto ga = GeneticAlgorithm<PathChromosome>(
-                problem,
-                cfg.population_size,
-                cfg.mutation_probability,
-                cfg.crossover_probability,
-                cfg.nr_of_elites);
-
         // run genetic algorithm until `nr_generations` or convergence criteria
-        while (true) {
-            ga.nextGeneration();
-
-            if (ga.hasConverged(cfg.convergence_threshold)
-                || ga.generation() >= cfg.nr_generations) {
-                avg_generation += ga.generation();
-                avg_objective += ga.objectiveValues().back();
-                break;
-            }
-        }
+        auto run = run_cached_ga(cache, graph, cfg, derived_seed(seed, i), 0);
+        avg_generation += run.generations;
+        avg_objective += std::max<double>(atLeast, run.objective);
     }
     return {avg_generation / runs, avg_objective / runs};
 }
 
-void runParamTests(std::string st, gal::LongestPathProblem::Problem & problem, RunParameters & cfg,
+void runParamTests(std::string st, const graph_lib::Graph & graph, int seed, RunParameters & cfg,
                    int number_of_runs_to_avg,
                    std::vector<int> &population_size_array,
                    std::vector<double> &mutation_probability_array,
@@ -49,7 +140,7 @@ void runParamTests(std::string st, gal::LongestPathProblem::Problem & problem, R
     auto cfgPop = cfg.population_size;
     for (auto population_size: population_size_array) {
         cfg.population_size = population_size;
-        auto ret = runGA(number_of_runs_to_avg, problem, cfg);
+        auto ret = runGA(number_of_runs_to_avg, graph, cfg, seed);
         // ret.first == average of generation under the number of runs
         // red.second== average objective value under the number of runs
         if (!selectOpt) {
@@ -73,7 +164,7 @@ void runParamTests(std::string st, gal::LongestPathProblem::Problem & problem, R
     auto cfgMut = cfg.mutation_probability;
     for (auto mutation_probability: mutation_probability_array) {
         cfg.mutation_probability = mutation_probability;
-        auto ret = runGA(number_of_runs_to_avg, problem, cfg);
+        auto ret = runGA(number_of_runs_to_avg, graph, cfg, seed);
         if (!selectOpt) {
             std::cout << st << mutation_probability << "," << ret.first << "," << ret.second
                                                            << std::endl;
@@ -96,7 +187,7 @@ void runParamTests(std::string st, gal::LongestPathProblem::Problem & problem, R
     auto cfgCro = cfg.crossover_probability;
     for (auto crossover_probability: cross_over_probability_array) {
         cfg.crossover_probability = crossover_probability;
-        auto ret = runGA(number_of_runs_to_avg, problem, cfg);
+        auto ret = runGA(number_of_runs_to_avg, graph, cfg, seed);
         if (!selectOpt) {
             std::cout << st << crossover_probability << "," << ret.first << "," << ret.second
                                                             << std::endl;
@@ -117,7 +208,7 @@ void runParamTests(std::string st, gal::LongestPathProblem::Problem & problem, R
     auto cfgEli = cfg.nr_of_elites;
     for (auto nr_of_elites: nr_of_elites_array) {
         cfg.nr_of_elites = nr_of_elites;
-        auto ret = runGA(number_of_runs_to_avg, problem, cfg);
+        auto ret = runGA(number_of_runs_to_avg, graph, cfg, seed);
         if (!selectOpt) {
             std::cout << st << nr_of_elites << "," << ret.first << "," << ret.second
                       << std::endl;
@@ -152,14 +243,14 @@ void naiveTests(){
             unsigned int graphnInput = graphNodes[graph_i];
             if (graphType == 2) graphnInput = 9;
             if (graphType == 5) graphnInput = 3*(graphNodes[graph_i] / 3) + 1;
-            auto graph = graph_lib::getGraphByType(graphType, graphnInput, graphP[graph_i], graphSeed[graph_i]);
-            auto problem = LongestPathProblem(graph, graphSeed[graph_i], cfg.crossover_type, cfg.local_search);
+            auto graph = graph_lib::getGraphByTypeCached(graphType, graphnInput, graphP[graph_i], graphSeed[graph_i],
+                                                          cfg.graph_snapshot_dir);
 
             std::cout<<"\t" << "Graph params: " << graphNodes[graph_i] << ", " << graphP[graph_i] << ", " << graphSeed[graph_i] << std::endl;
             std::cout<<"\t" << "[" <<std::endl;
             std::string st = "\t\t";
 
-            runParamTests(st, problem, cfg, number_of_runs_to_avg,
+            runParamTests(st, graph, graphSeed[graph_i], cfg, number_of_runs_to_avg,
                           population_size_array,
                           mutation_probability_array,
                           cross_over_probability_array,
@@ -191,14 +282,14 @@ void cfgTests(){
             unsigned int graphnInput = graphNodes[graph_i];
             if (graphType == 2) graphnInput = 9;
             if (graphType == 5) graphnInput = 3*(graphNodes[graph_i] / 3) + 1;
-            auto graph = graph_lib::getGraphByType(graphType, graphnInput, graphP[graph_i], graphSeed[graph_i]);
-            auto problem = LongestPathProblem(graph, graphSeed[graph_i], cfg.crossover_type, cfg.local_search);
+            auto graph = graph_lib::getGraphByTypeCached(graphType, graphnInput, graphP[graph_i], graphSeed[graph_i],
+                                                          cfg.graph_snapshot_dir);
 
             std::cout<<"\t" << "Graph params: " << graphNodes[graph_i] << ", " << graphP[graph_i] << ", " << graphSeed[graph_i] << std::endl;
             std::cout<<"\t" << "[" <<std::endl;
             std::string st = "\t\t";
 
-            runParamTests(st, problem, cfg, number_of_runs_to_avg,
+            runParamTests(st, graph, graphSeed[graph_i], cfg, number_of_runs_to_avg,
                           population_size_array,
                           mutation_probability_array,
                           cross_over_probability_array,
@@ -213,21 +304,62 @@ void cfgTests(){
     }
 }
 
-void runTimedAlgTests(int runs, graph_lib::Graph & graph, RunParameters & cfg, int seed){
+/**
+ * Optimal path length of graph if it is a tree, cycle or made of small blocks, or small enough to solve exactly (at
+ * most referenceMaxNodes or cfg.exact_max_nodes nodes), else -1. The experiments measure the GA against it, so it is
+ * computed whether or not the parameters let the drivers skip the GA.
+ */
+double exactOptimum(const graph_lib::Graph & graph, const RunParameters & cfg){
+    constexpr unsigned int referenceMaxNodes = 16;
+    if (auto structured = graph_lib::longestPathStructured(graph)) return static_cast<double>(structured->length);
+    if (graph.getNodeCount() > std::max(referenceMaxNodes, cfg.exact_max_nodes)) return -1;
+    return static_cast<double>(graph_lib::longestPathDp(graph).length);
+}
+
+void runTimedAlgTests(int runs, graph_lib::Graph & graph, const RunParameters & cfg, int seed){
+    // The relative gap between the GA and the optimum is printed as a fourth column, when the optimum is known.
+    double optimum = exactOptimum(graph, cfg);
+    if (optimum >= 0) std::cout << "optimum: " << optimum << std::endl;
+    std::optional<graph_lib::Reduction> reduction;
+    if (cfg.graph_reduce) reduction = graph_lib::reduceGraph(graph);
+    const auto & reducedGraph = reduction ? reduction->graph : graph;
+    // Renumbering keeps path lengths, so the GA's values need no mapping back.
+    std::optional<graph_lib::Relabeling> relabeling;
+    auto order = graph_lib::parseNodeOrder(cfg.graph_order);
+    if (order != graph_lib::NodeOrder::Original) relabeling = graph_lib::relabelGraph(reducedGraph, order);
+    const auto & searchGraph = relabeling ? relabeling->graph : reducedGraph;
+    const double atLeast = reduction ? static_cast<double>(reduction->internal.length) : 0;
     std::vector<bool> localSearch = {false, false, false, false, true};
     std::vector<int> crossType = {0, 1, 2, 3, 0};
+    // The runs are timed, so they bypass result_cache_dir, a cached run would report the time of the lookup.
+    RunParameters timed = cfg;
+    timed.result_cache_dir.clear();
+    // Hardware counts of each run are printed after it, with the misses per decode step in GAL_INSTRUMENT builds and a
+    // note that they need one otherwise.
+    std::optional<graph_lib::PerfCounters> perf;
+    if (cfg.perf_counters) {
+        perf.emplace();
+        if (!perf->available()) std::cout << "No hardware counters: " << perf->reason() << std::endl;
+    }
     for (int i = 0; i < localSearch.size(); i++) {
-        cfg.local_search = localSearch[i];
-        cfg.crossover_type = crossType[i];
-        auto problem = LongestPathProblem(graph, seed, cfg.crossover_type, cfg.local_search);
+        timed.local_search = localSearch[i];
+        timed.crossover_type = crossType[i];
         std::cout << localSearch[i] << ", " << crossType[i] << ": \t";
         auto start = std::chrono::system_clock::now();
+        auto startCounts = perf ? perf->read() : graph_lib::PerfSample{};
+        auto startWork = graph_lib::workCounters();
 
-        auto ret = runGA(runs, problem, cfg);
+        auto ret = runGA(runs, searchGraph, timed, seed, atLeast);
 
         auto end = std::chrono::system_clock::now();
         std::chrono::duration<double> elapsed_seconds = end - start;
-        std::cout << ret.first << ", " << ret.second << ", " << elapsed_seconds.count() << std::endl;
+        std::cout << ret.first << ", " << ret.second << ", " << elapsed_seconds.count();
+        if (optimum > 0) std::cout << ", " << (optimum - ret.second) / optimum;
+        if (perf && perf->available()) {
+            auto steps = (graph_lib::workCounters() - startWork).decodeSteps;
+            std::cout << " \t(" << (perf->read() - startCounts).summary(steps) << ")";
+        }
+        std::cout << std::endl;
     }
 }
 
@@ -238,7 +370,7 @@ void graphExTests(){
     RunParameters cfg = read_parameter_file();
     int runs_to_avg = 10;
     for (int i = 0; i < graphTypes.size(); i++) {
-        auto graph = graph_lib::getGraphByType(graphTypes[i], graphNodes[i], 0, 0);
+        auto graph = graph_lib::getGraphByTypeCached(graphTypes[i], graphNodes[i], 0, 0, cfg.graph_snapshot_dir);
         std::cout<< "graph : " << i << " [" << std::endl;
         runTimedAlgTests(runs_to_avg, graph, cfg, seeds[i]);
         std::cout<< "]" << std::endl;
@@ -254,7 +386,8 @@ void graphRandomTests(){
     RunParameters cfg = read_parameter_file();
     int runs_to_avg = 10;
     for (int i = 0; i < graphTypes.size(); i++) {
-        auto graph = graph_lib::getGraphByType(graphTypes[i], graphNodes[i], graphPs[i], 0);
+        auto graph = graph_lib::getGraphByTypeCached(graphTypes[i], graphNodes[i], graphPs[i], 0,
+                                                     cfg.graph_snapshot_dir);
         std::cout<< "graph : " << i << " [" << std::endl;
         runTimedAlgTests(runs_to_avg, graph, cfg, seeds[i]);
         std::cout<< "]" << std::endl;
@@ -262,8 +395,488 @@ void graphRandomTests(){
 
 }
 
+/**
+ * The best objective of a GA run over time, a point per generation that improved it.
+ */
+struct RunTrace {
+    std::vector<std::pair<double, double>> points;  // (seconds since the start, best objective so far)
+    double seconds = 0;                             // Until convergence, the generation limit or the time limit
+
+    // The best objective at time t, 0 before the first generation.
+    double bestAt(double t) const {
+        double best = 0;
+        for (auto [time, objective] : points) {
+            if (time > t) break;
+            best = objective;
+        }
+        return best;
+    }
+
+    // The first time the best objective reached target, infinity if it never did.
+    double timeTo(double target) const {
+        for (auto [time, objective] : points) {
+            if (objective >= target) return time;
+        }
+        return std::numeric_limits<double>::infinity();
+    }
+};
+
+/**
+ * A GA run whose random numbers all derive from seed, as in run_seeded_ga, stopping at cfg's generation and convergence
+ * limits, after timeLimit seconds or once target is reached. Seeded chromosomes are built with seedThreads threads.
+ */
+RunTrace traceGA(const graph_lib::Graph & graph, const RunParameters & cfg, std::uint32_t seed,
+                 unsigned int seedThreads, double target, double timeLimit){
+    engine.seed(seed);
+    RunTrace trace;
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+    auto problem = LongestPathProblem(graph, static_cast<int>(seed), cfg.crossover_type, cfg.local_search,
+                                      cfg.seed_fraction, graph_lib::parsePathDecoder(cfg.decoder));
+    problem.setSeedThreads(seedThreads);
+    auto ga = GeneticAlgorithm<PathChromosome>(
+            problem,
+            cfg.population_size,
+            cfg.mutation_probability,
+            cfg.crossover_probability,
+            cfg.nr_of_elites);
+    while (true) {
+        ga.nextGeneration();
+        double best = ga.objectiveValues().back();
+        if (trace.points.empty() || best > trace.points.back().second) trace.points.emplace_back(elapsed(), best);
+        if (best >= target || elapsed() >= timeLimit || ga.hasConverged(cfg.convergence_threshold)
+            || ga.generation() >= cfg.nr_generations) break;
+    }
+    trace.seconds = elapsed();
+    return trace;
+}
+
+/**
+ * Compares GA configurations by how fast they get how close to the optimum, over many seeds on instances with a known
+ * optimum (structured graphs, small ones solved exactly and the planted path benchmark graphs). Prints CSV lines, which are easy to plot:
+ *   ttt,instance,config,target,run,seconds,probability     time-to-target distribution: the sorted times at which
+ *                                                          the runs reached target * optimum, against the fraction
+ *                                                          of runs done by then; runs that never did are left out
+ *   profile,instance,config,seconds,mean,min,max           anytime performance profile: best objective at that time
+ *                                                          as a fraction of the optimum, over the runs
+ * The optimum is the exact one if it can be computed, otherwise the best value found by any run. Every run builds its
+ * own problem from its seed. The GA itself runs on one thread, the *_seed_threads configurations only build the
+ * seeded chromosomes on more threads, so they differ from random in time alone and only with seed_fraction above 0.
+ */
+void timeToTargetTests(){
+    struct Configuration {
+        std::string name;
+        int crossType;
+        bool localSearch;
+        unsigned int seedThreads;   // See LongestPathProblem::setSeedThreads
+    };
+    std::vector<Configuration> configurations = {
+            {"random", 0, false, 1}, {"uniform", 1, false, 1}, {"optimum", 2, false, 1}, {"path_pos", 3, false, 1},
+            {"random_ls", 0, true, 1}, {"random_4_seed_threads", 0, false, 4},
+            {"random_all_seed_threads", 0, false, 0}};
+    std::vector<unsigned int> graphTypes = {3, 4, 5, 6, 8, 8, 9, 12, 13};
+    std::vector<int> graphNodes = {25, 25, 25, 25, 16, 200, 1000, 1000, 1000};
+    std::vector<double> graphPs = {0, 0, 0, 0, 0.3, 0.02, 4, 4, 4};
+    std::vector<double> targets = {0.9, 0.95, 1.0};
+    std::vector<double> profileTimes = {0.001, 0.003, 0.01, 0.03, 0.1, 0.3, 1, 3};
+    const int runs = 20;
+    const double timeLimit = profileTimes.back();
+    RunParameters cfg = read_parameter_file();
+
+    for (std::size_t i = 0; i < graphTypes.size(); i++) {
+        auto graph = graph_lib::getGraphByTypeCached(graphTypes[i], graphNodes[i], graphPs[i], static_cast<int>(i + 1),
+                                                     cfg.graph_snapshot_dir);
+        const std::string instance = "type" + std::to_string(graphTypes[i]) + "_n" + std::to_string(graphNodes[i]);
+        auto known = graph_lib::knownOptimum(graphTypes[i], graphNodes[i]);
+        double optimum = known ? static_cast<double>(*known) : exactOptimum(graph, cfg);
+        const bool exact = optimum > 0;
+
+        std::vector<std::vector<RunTrace>> traces(configurations.size());
+        for (std::size_t c = 0; c < configurations.size(); c++) {
+            auto & configuration = configurations[c];
+            cfg.crossover_type = configuration.crossType;
+            cfg.local_search = configuration.localSearch;
+            for (int run = 0; run < runs; run++) {
+                // Without a known optimum every run has to use its time, so the best value found is a fair reference.
+                const double stopAt = exact ? optimum : std::numeric_limits<double>::infinity();
+                traces[c].push_back(traceGA(graph, cfg, derived_seed(i + 1, run), configuration.seedThreads, stopAt,
+                                            timeLimit));
+                if (!exact) optimum = std::max(optimum, traces[c].back().points.back().second);
+            }
+        }
+        std::cout << "instance," << instance << "," << graph.getNodeCount() << " nodes," << optimum
+                  << (exact ? ",exact" : ",best found") << std::endl;
+
+        for (std::size_t c = 0; c < configurations.size(); c++) {
+            const auto & name = configurations[c].name;
+            for (auto target : targets) {
+                std::vector<double> times;
+                for (auto & trace : traces[c]) times.push_back(trace.timeTo(target * optimum));
+                std::sort(times.begin(), times.end());
+                for (int run = 0; run < runs && std::isfinite(times[run]); run++) {
+                    std::cout << "ttt," << instance << "," << name << "," << target << "," << run << ","
+                              << times[run] << "," << (run + 0.5) / runs << std::endl;
+                }
+            }
+            for (auto t : profileTimes) {
+                double sum = 0, min = std::numeric_limits<double>::infinity(), max = 0;
+                for (auto & trace : traces[c]) {
+                    // A run that stopped early (converged or reached the optimum) keeps its final value.
+                    double quality = optimum > 0 ? trace.bestAt(t) / optimum : 1;
+                    sum += quality;
+                    min = std::min(min, quality);
+                    max = std::max(max, quality);
+                }
+                std::cout << "profile," << instance << "," << name << "," << t << "," << sum / runs << "," << min
+                          << "," << max << std::endl;
+            }
+        }
+    }
+}
+
+/**
+ * A parameter sweep: every graph, every combination of the axis values and every repetition is an independent GA run.
+ */
+struct SweepSpec {
+    struct GraphSpec {
+        int type;
+        int nodes;
+        double param2;
+        int seed;
+    };
+    RunParameters base;                 // Parameters the axes do not vary, from the parameter file
+    std::vector<GraphSpec> graphs;
+    std::vector<std::pair<std::string, std::vector<std::string>>> axes;    // Parameter key and its values
+    int repetitions = 1;
+    unsigned int threads = 0;           // 0 for all cores
+    std::uint64_t seed = 1;             // Every run's seed is derived from this and the run's index
+    std::string output = "sweep.csv";   // JSON lines if it ends in .jsonl, CSV otherwise
+    std::map<std::string, std::string> options;     // Keys of other commands using the same file format
+};
+
+std::vector<std::string> split_list(const std::string &text, char separator = ',') {
+    std::vector<std::string> items;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, separator)) items.emplace_back(trim(item));
+    return items;
+}
 
-int main() {
+/**
+ * Reads a sweep file of "key = value" lines ('#' starts a comment):
+ *   graphs = 8:200:0.02:1, 9:1000:4:1     type:nodes:param2:seed of every graph, as for getGraphByType
+ *   repetitions = 5
+ *   threads = 0
+ *   seed = 1
+ *   output = sweep.csv
+ * Any other key is a parameter of the parameter file, with a comma separated list of the values to sweep over.
+ */
+SweepSpec read_sweep_file(const std::string &filename, RunParameters base,
+                          const std::set<std::string> &optionKeys = {}) {
+    std::ifstream file(filename);
+    if (!file) throw std::invalid_argument("Sweep file " + filename + " does not exist.");
+    SweepSpec spec;
+    spec.base = std::move(base);
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        auto separator = line.find('=');
+        if (separator == std::string::npos) continue;
+        std::string key(trim(line.substr(0, separator)));
+        std::string value(trim(line.substr(separator + 1)));
+        if (key == "graphs") {
+            for (auto & graph : split_list(value)) {
+                auto fields = split_list(graph, ':');
+                if (fields.size() != 4) throw std::invalid_argument("Expected type:nodes:param2:seed, got " + graph);
+                spec.graphs.push_back({std::stoi(fields[0]), std::stoi(fields[1]), std::stod(fields[2]),
+                                       std::stoi(fields[3])});
+            }
+        } else if (key == "repetitions") {
+            spec.repetitions = std::stoi(value);
+        } else if (key == "threads") {
+            spec.threads = std::stoul(value);
+        } else if (key == "seed") {
+            spec.seed = std::stoull(value);
+        } else if (key == "output") {
+            spec.output = value;
+        } else if (optionKeys.contains(key)) {
+            spec.options[key] = value;
+        } else {
+            auto values = split_list(value);
+            RunParameters check = spec.base;
+            for (auto & v : values) set_parameter(check, key, v);  // Fails early on unknown keys and bad values
+            spec.axes.emplace_back(key, values);
+        }
+    }
+    if (spec.graphs.empty()) throw std::invalid_argument("Sweep file " + filename + " lists no graphs.");
+    return spec;
+}
+
+/**
+ * The graphs of a sweep, each with its optimum: known, computed exactly if small enough, or -1.
+ */
+std::pair<std::vector<graph_lib::Graph>, std::vector<double>> build_sweep_graphs(const SweepSpec &spec) {
+    std::vector<graph_lib::Graph> graphs;
+    std::vector<double> optima;
+    for (auto & g : spec.graphs) {
+        graphs.push_back(graph_lib::getGraphByTypeCached(g.type, g.nodes, g.param2, g.seed,
+                                                         spec.base.graph_snapshot_dir));
+        auto known = graph_lib::knownOptimum(g.type, g.nodes);
+        optima.push_back(known ? static_cast<double>(*known) : exactOptimum(graphs.back(), spec.base));
+    }
+    return {std::move(graphs), std::move(optima)};
+}
+
+/**
+ * Every combination of the axis values on top of the base parameters, the last axis varying fastest, with the values
+ * that make up each combination.
+ */
+std::pair<std::vector<RunParameters>, std::vector<std::vector<std::string>>> expand_axes(const SweepSpec &spec) {
+    std::vector<RunParameters> configs = {spec.base};
+    std::vector<std::vector<std::string>> labels = {{}};
+    for (auto & [key, values] : spec.axes) {
+        std::vector<RunParameters> nextConfigs;
+        std::vector<std::vector<std::string>> nextLabels;
+        for (std::size_t c = 0; c < configs.size(); c++) {
+            for (auto & value : values) {
+                nextConfigs.push_back(configs[c]);
+                set_parameter(nextConfigs.back(), key, value);
+                nextLabels.push_back(labels[c]);
+                nextLabels.back().push_back(value);
+            }
+        }
+        configs = std::move(nextConfigs);
+        labels = std::move(nextLabels);
+    }
+    return {std::move(configs), std::move(labels)};
+}
+
+/**
+ * Runs a sweep on a work stealing thread pool. Graphs are built once and shared read-only by all runs. Every run has
+ * its own random streams derived from spec.seed and its index, so the results do not depend on the number of threads
+ * or the order runs finish in. Results are written in run order as soon as all runs before them are done.
+ */
+void runSweep(const SweepSpec &spec){
+    const auto [graphs, optima] = build_sweep_graphs(spec);
+    const auto [configs, labels] = expand_axes(spec);
+    const std::size_t runsPerGraph = configs.size() * spec.repetitions;
+    const std::size_t runs = graphs.size() * runsPerGraph;
+    const bool json = spec.output.ends_with(".jsonl");
+    std::ofstream out(spec.output);
+    out.precision(12);
+    if (!json) {
+        out << "run,graph_type,graph_nodes,graph_param2,graph_seed";
+        for (auto & axis : spec.axes) out << ',' << axis.first;
+        out << ",repetition,seed,generations,objective,optimum,gap,seconds\n";
+    }
+    auto write = [&](std::size_t run, const SeededRun &result) {
+        const auto g = run / runsPerGraph, c = run % runsPerGraph / spec.repetitions;
+        const auto repetition = run % spec.repetitions;
+        const auto & graph = spec.graphs[g];
+        const double optimum = optima[g];
+        const double gap = optimum > 0 ? (optimum - result.objective) / optimum : -1;
+        if (json) {
+            out << "{\"run\":" << run << ",\"graph_type\":" << graph.type << ",\"graph_nodes\":" << graph.nodes
+                << ",\"graph_param2\":" << graph.param2 << ",\"graph_seed\":" << graph.seed;
+            for (std::size_t a = 0; a < spec.axes.size(); a++)
+                out << ",\"" << spec.axes[a].first << "\":\"" << labels[c][a] << '"';
+            out << ",\"repetition\":" << repetition << ",\"seed\":" << result.seed << ",\"generations\":"
+                << result.generations << ",\"objective\":" << result.objective << ",\"optimum\":" << optimum
+                << ",\"gap\":" << gap << ",\"seconds\":" << result.seconds << "}\n";
+        } else {
+            out << run << ',' << graph.type << ',' << graph.nodes << ',' << graph.param2 << ',' << graph.seed;
+            for (auto & value : labels[c]) out << ',' << value;
+            out << ',' << repetition << ',' << result.seed << ',' << result.generations << ',' << result.objective
+                << ',' << optimum << ',' << gap << ',' << result.seconds << '\n';
+        }
+        out.flush();
+    };
+
+    graph_lib::ResultCache cache(spec.base.result_cache_dir, longestPathVersion);
+    std::mutex mutex;
+    std::vector<std::optional<SeededRun>> results(runs);
+    std::size_t written = 0;
+    graph_lib::WorkStealingPool pool(spec.threads);
+    for (std::size_t run = 0; run < runs; run++) {
+        pool.submit([&, run] {
+            auto result = run_cached_ga(cache, graphs[run / runsPerGraph],
+                                        configs[run % runsPerGraph / spec.repetitions], derived_seed(spec.seed, run));
+
+            std::lock_guard lock(mutex);
+            results[run] = result;
+            while (written < runs && results[written]) {
+                write(written, *results[written]);
+                written++;
+            }
+        });
+    }
+    pool.wait();
+    std::cout << "Wrote " << runs << " runs to " << spec.output << std::endl;
+}
+
+
+/**
+ * Races the configurations of a sweep file by successive halving: every configuration gets min_runs runs, then only
+ * the best 1/eta of them go on with eta times as many runs, until one is left or max_runs is reached. Run k of every
+ * configuration uses the same graph and seed, so configurations are compared on equal terms. A run scores its
+ * objective relative to the optimum of its graph, or to the best objective found on it when that is unknown.
+ *
+ * Besides the keys of read_sweep_file, the file may set min_runs (default 2), eta (3), max_runs (0 = no limit),
+ * max_configurations (0 = all, else a seeded random sample) and log (tune.csv). Every finished run is appended to the
+ * log with its run_key, and runs whose key is already in it are not repeated, so an interrupted or extended race
+ * resumes where it stopped. Runs of another graph or with other parameters than the axes show have other keys.
+ */
+void runTune(const SweepSpec &spec) {
+    auto option = [&](const std::string &key, const std::string &fallback) {
+        auto it = spec.options.find(key);
+        return it == spec.options.end() ? fallback : it->second;
+    };
+    const std::size_t minRuns = std::stoul(option("min_runs", "2"));
+    const std::size_t eta = std::stoul(option("eta", "3"));
+    const std::size_t maxRuns = std::stoul(option("max_runs", "0"));
+    const std::size_t maxConfigurations = std::stoul(option("max_configurations", "0"));
+    const std::string logFile = option("log", "tune.csv");
+    if (minRuns == 0 || eta < 2) throw std::invalid_argument("Racing needs min_runs >= 1 and eta >= 2.");
+
+    const auto [graphs, optima] = build_sweep_graphs(spec);
+    const auto [configs, values] = expand_axes(spec);
+    std::vector<std::string> labels;
+    for (auto & configValues : values) {
+        std::string label;
+        for (std::size_t a = 0; a < spec.axes.size(); a++)
+            label += (a > 0 ? ";" : "") + spec.axes[a].first + '=' + configValues[a];
+        labels.push_back(label);
+    }
+    std::vector<std::size_t> alive(configs.size());
+    std::iota(alive.begin(), alive.end(), 0);
+    if (maxConfigurations > 0 && maxConfigurations < alive.size()) {
+        std::mt19937 gen(static_cast<std::uint32_t>(spec.seed));
+        std::shuffle(alive.begin(), alive.end(), gen);
+        alive.resize(maxConfigurations);
+        std::sort(alive.begin(), alive.end());
+    }
+
+    // Results of earlier races by run_key, and the runs of this race by configuration label and run.
+    const std::string logHeader = "config,graph,run,seed,run_key,generations,objective,seconds";
+    std::map<std::uint64_t, SeededRun> logged;
+    std::map<std::string, std::map<std::size_t, SeededRun>> done;
+    bool header = true;
+    if (std::ifstream in(logFile); in) {
+        std::string line;
+        std::getline(in, line);
+        header = line.empty();
+        if (!header && line != logHeader)
+            throw std::runtime_error(logFile + " has other columns than " + logHeader + ", move it or set log.");
+        while (std::getline(in, line)) {
+            auto fields = split_list(line);
+            if (fields.size() != 8) continue;  // E.g. a line cut short when the previous race was interrupted
+            logged[std::stoull(fields[4])] = {static_cast<std::uint32_t>(std::stoul(fields[3])), std::stoi(fields[5]),
+                                              std::stod(fields[6]), std::stod(fields[7]), {}};
+        }
+    }
+    std::ofstream log(logFile, std::ios::app);
+    log.precision(12);
+    if (header) log << logHeader << '\n';
+
+    graph_lib::ResultCache cache(spec.base.result_cache_dir, longestPathVersion);
+    std::mutex mutex;
+    graph_lib::WorkStealingPool pool(spec.threads);
+    std::size_t budget = maxRuns > 0 ? std::min(minRuns, maxRuns) : minRuns;
+    for (int round = 1;; round++) {
+        // The runs to start are listed first and each worker writes only its own slot, done is merged after wait().
+        struct Pending {
+            std::size_t config, run;
+            std::uint32_t seed;
+            std::uint64_t key;
+        };
+        std::vector<Pending> pending;
+        std::size_t reused = 0;
+        for (auto c : alive) {
+            auto & runs = done[labels[c]];
+            for (std::size_t run = 0; run < budget; run++) {
+                if (runs.contains(run)) continue;
+                const auto seed = derived_seed(spec.seed, run);
+                const auto key = run_key(graphs[run % graphs.size()], configs[c], seed);
+                if (auto it = logged.find(key); it != logged.end()) {
+                    runs[run] = it->second;
+                    reused++;
+                    continue;
+                }
+                pending.push_back({c, run, seed, key});
+            }
+        }
+        const std::size_t started = pending.size();
+        std::vector<SeededRun> results(started);
+        for (std::size_t i = 0; i < started; i++) {
+            pool.submit([&, i] {
+                const auto & [c, run, seed, key] = pending[i];
+                results[i] = run_cached_ga(cache, graphs[run % graphs.size()], configs[c], seed);
+                const auto & result = results[i];
+                std::lock_guard lock(mutex);
+                log << labels[c] << ',' << run % graphs.size() << ',' << run << ',' << result.seed << ',' << key
+                    << ',' << result.generations << ',' << result.objective << ',' << result.seconds << '\n';
+                log.flush();
+            });
+        }
+        pool.wait();
+        for (std::size_t i = 0; i < started; i++) done[labels[pending[i].config]][pending[i].run] = results[i];
+
+        std::vector<double> reference = optima;
+        for (auto & [label, runs] : done) {
+            for (auto & [run, result] : runs) {
+                auto & r = reference[run % graphs.size()];
+                if (optima[run % graphs.size()] <= 0) r = std::max(r, result.objective);
+            }
+        }
+        std::vector<double> score(configs.size());
+        for (auto c : alive) {
+            for (std::size_t run = 0; run < budget; run++) {
+                const double best = reference[run % graphs.size()];
+                if (best > 0) score[c] += done[labels[c]][run].objective / best;
+            }
+            score[c] /= static_cast<double>(budget);
+        }
+        std::stable_sort(alive.begin(), alive.end(), [&](auto a, auto b) { return score[a] > score[b]; });
+
+        std::cout << "Round " << round << ": " << alive.size() << " configurations x " << budget << " runs ("
+                  << started << " run, " << reused << " from " << logFile << ")" << std::endl;
+        for (std::size_t i = 0; i < std::min<std::size_t>(alive.size(), 5); i++)
+            std::cout << "  " << score[alive[i]] << "  " << labels[alive[i]] << std::endl;
+
+        if (alive.size() <= 1 || (maxRuns > 0 && budget >= maxRuns)) break;
+        alive.resize((alive.size() + eta - 1) / eta);
+        if (alive.size() == 1) break;
+        budget = maxRuns > 0 ? std::min(budget * eta, maxRuns) : budget * eta;
+    }
+
+    std::cout << "Best configuration:" << std::endl;
+    for (std::size_t a = 0; a < spec.axes.size(); a++)
+        std::cout << spec.axes[a].first << " = " << values[alive.front()][a] << std::endl;
+}
+
+int main(int argc, char ** argv) {
+    // "ttt" picks the time-to-target comparison, "sweep <file>" runs a parameter sweep (see read_sweep_file),
+    // "tune <file>" races the configurations of a sweep file (see runTune), "prune_cache" deletes the cached runs of
+    // older versions from result_cache_dir, other experiments are selected by (un)commenting below.
+    if (argc > 1 && std::string(argv[1]) == "ttt") {
+        timeToTargetTests();
+        return 0;
+    }
+    if (argc > 2 && std::string(argv[1]) == "sweep") {
+        runSweep(read_sweep_file(argv[2], read_parameter_file()));
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "prune_cache") {
+        auto cfg = read_parameter_file();
+        auto removed = graph_lib::ResultCache(cfg.result_cache_dir, longestPathVersion).prune();
+        std::cout << "Removed " << removed << " cached runs from '" << cfg.result_cache_dir << "'" << std::endl;
+        return 0;
+    }
+    if (argc > 2 && std::string(argv[1]) == "tune") {
+        runTune(read_sweep_file(argv[2], read_parameter_file(),
+                                {"min_runs", "eta", "max_runs", "max_configurations", "log"}));
+        return 0;
+    }
     //naiveTests();
     //cfgTests();
     //graphExTests();
@@ -285,13 +898,80 @@ std::string_view trim(std::string_view s) {
     return s;
 }
 
+/**
+ * Sets the parameter called key, as in the parameter file, to value.
+ */
+void set_parameter(RunParameters &config, const std::string &key, const std::string &value) {
+    if (key == "graph_type") {
+        config.graph_type = std::stoi(value);
+    } else if (key == "graph_nodes") {
+        config.graph_nodes = std::stoi(value);
+    } else if (key == "graph_p") {
+        config.graph_p = std::stod(value);
+    } else if (key == "graph_snapshot_dir") {
+        config.graph_snapshot_dir = value;
+    } else if (key == "random_seed") {
+        config.random_seed = std::stoi(value);
+    } else if (key == "graph_override_ones") {
+        config.graph_override_ones = value == "true";
+    } else if (key == "graph_reduce") {
+        config.graph_reduce = value == "true";
+    } else if (key == "graph_order") {
+        config.graph_order = value;
+    } else if (key == "nr_generations") {
+        config.nr_generations = std::stoi(value);
+    } else if (key == "population_size") {
+        config.population_size = std::stoi(value);
+    } else if (key == "chromosome_length") {
+        config.chromosome_length = std::stoi(value);
+    } else if (key == "mutation_probability") {
+        config.mutation_probability = std::stod(value);
+    } else if (key == "crossover_probability") {
+        config.crossover_probability = std::stod(value);
+    } else if (key == "convergence_threshold") {
+        config.convergence_threshold = std::stoi(value);
+    } else if (key == "nr_of_elites") {
+        config.nr_of_elites = std::stoi(value);
+    } else if (key == "crossover_type") {
+        config.crossover_type = std::stoi(value);
+    } else if (key == "local_search") {
+        config.local_search = value == "true";
+    } else if (key == "seed_fraction") {
+        config.seed_fraction = std::stod(value);
+    } else if (key == "decoder") {
+        config.decoder = value;
+    } else if (key == "exact_max_nodes") {
+        config.exact_max_nodes = std::stoul(value);
+    } else if (key == "structured_solve") {
+        config.structured_solve = value == "true";
+    } else if (key == "bnb_time_limit") {
+        config.bnb_time_limit = std::stod(value);
+    } else if (key == "stats_file") {
+        config.stats_file = value;
+    } else if (key == "perf_counters") {
+        config.perf_counters = value == "true";
+    } else if (key == "result_cache_dir") {
+        config.result_cache_dir = value;
+    } else if (key == "checkpoint_file") {
+        config.checkpoint_file = value;
+    } else if (key == "checkpoint_interval") {
+        config.checkpoint_interval = std::stoi(value);
+    } else if (key == "print_interval") {
+        config.print_interval = std::stoi(value);
+    } else if (key == "graph_weight_type") {
+        config.graph_weight_type = value;
+    } else {
+        throw std::runtime_error("Could not parse unknown parameter with key '" + key + "'.");
+    }
+}
+
 /**
  * Read a parameter file.
  *
  * @param filename
  * @return
  */
-RunParameters read_parameter_file(const std::string &filename) {
+RunParameters read_parameter_file(const std::string &filename, RunParameters config) {
     if (!std::filesystem::exists(filename)) {
         throw std::invalid_argument(
                 "Input file " + filename
@@ -303,7 +983,6 @@ RunParameters read_parameter_file(const std::string &filename) {
 
     std::ifstream file;
     file.open(filename);
-    auto config = RunParameters();
 
     std::string line;
     while (std::getline(file, line)) {
@@ -314,37 +993,7 @@ RunParameters read_parameter_file(const std::string &filename) {
             key = trim(key);
             if (std::getline(in_line, value)) {
                 value = trim(value);
-                if (key == "graph_type") {
-                    config.graph_type = std::stoi(value);
-                } else if (key == "graph_nodes") {
-                    config.graph_nodes = std::stoi(value);
-                } else if (key == "graph_p") {
-                    config.graph_p = std::stod(value);
-                } else if (key == "random_seed") {
-                    config.random_seed = std::stoi(value);
-                } else if (key == "graph_override_ones") {
-                    config.graph_override_ones = value == "true";
-                } else if (key == "nr_generations") {
-                    config.nr_generations = std::stoi(value);
-                } else if (key == "population_size") {
-                    config.population_size = std::stoi(value);
-                } else if (key == "chromosome_length") {
-                    config.chromosome_length = std::stoi(value);
-                } else if (key == "mutation_probability") {
-                    config.mutation_probability = std::stod(value);
-                } else if (key == "crossover_probability") {
-                    config.crossover_probability = std::stod(value);
-                } else if (key == "convergence_threshold") {
-                    config.convergence_threshold = std::stoi(value);
-                } else if (key == "nr_of_elites") {
-                    config.nr_of_elites = std::stoi(value);
-                }else if (key == "crossover_type") {
-                    config.crossover_type = std::stoi(value);
-                } else if (key == "local_search") {
-                    config.local_search = value == "true";
-                } else {
-                    throw std::runtime_error("Could not parse unknown parameter with key '" + key + "'.");
-                }
+                set_parameter(config, key, value);
             }
         }
     }
@@ -0,0 +1,178 @@
+//
+// Created on 18/10/2026.
+//
+// Decodes the same chromosomes and runs a few GA generations on a large sparse graph in its generated numbering and
+// after every relabeling, and prints the wall time of both relative to the generated numbering, and the L1 data and
+// last level cache misses per decode step read from the hardware counters (see PerfCounters, "-" where they cannot be
+// read). The mean id gap between the nodes of an edge (and of consecutive path nodes) is printed as well, as a hint at
+// why the misses change. Configure with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+//
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include "../include/graph.h"
+#include "../include/perfCounters.h"
+#include "../include/randomGraph.h"
+#include "../include/relabel.h"
+#include "longest_path_problem/longest_path_problem.hpp"
+#include "../include/algorithm.hpp"
+
+namespace {
+    using namespace graph_lib;
+
+    // Every chromosome has a gene per node, so the GA runs on a small population for a few generations only.
+    constexpr int gaPopulation = 20;
+    constexpr int gaGenerations = 5;
+
+    // A side x side grid with random weights whose node ids are shuffled, like a road network read in arbitrary order.
+    Graph shuffledGrid(unsigned int side, std::mt19937 & gen) {
+        const unsigned int n = side * side;
+        std::vector<unsigned int> id(n + 1);
+        std::iota(id.begin(), id.end(), 0);
+        std::shuffle(id.begin() + 1, id.end(), gen);
+        std::uniform_int_distribution<std::uint32_t> weight(1, 20);
+        EdgeList edges;
+        for (unsigned int r = 0; r < side; r++) {
+            for (unsigned int c = 0; c < side; c++) {
+                const auto v = r * side + c + 1;
+                if (c + 1 < side) edges.push_back({id[v], id[v + 1], weight(gen)});
+                if (r + 1 < side) edges.push_back({id[v], id[v + side], weight(gen)});
+            }
+        }
+        return Graph(edges, n);
+    }
+
+    // Chromosomes whose paths are long: the genes along a random self avoiding walk point to the next node of the
+    // walk, every other gene to a random neighbour.
+    std::vector<std::vector<unsigned int>> walkChromosomes(const Graph & graph, unsigned int count,
+                                                           std::mt19937 & gen) {
+        const unsigned int n = graph.getNodeCount();
+        std::uniform_int_distribution<unsigned int> node(1, n);
+        std::vector<std::vector<unsigned int>> chromosomes;
+        std::vector<bool> visited(n + 1);
+        std::vector<unsigned int> open;
+        for (unsigned int c = 0; c < count; c++) {
+            std::vector<unsigned int> genes(n + 1);
+            for (unsigned int v = 1; v <= n; v++) genes[v] = graph.getRandomEdge(v, gen);
+            std::fill(visited.begin(), visited.end(), false);
+            auto current = genes[0] = node(gen);
+            while (true) {
+                visited[current] = true;
+                open.clear();
+                for (auto u : graph.getNeighbours(current)) {
+                    if (!visited[u]) open.push_back(u);
+                }
+                if (open.empty()) break;
+                current = genes[current] = open[gen() % open.size()];
+            }
+            chromosomes.push_back(std::move(genes));
+        }
+        return chromosomes;
+    }
+
+    // Wall time of gaGenerations generations in ms, the GA and the problem are seeded the same for every order.
+    double gaMilliseconds(const Graph & graph) {
+        engine.seed(3);
+        auto problem = gal::LongestPathProblem(graph, 5);
+        auto start = std::chrono::steady_clock::now();
+        auto ga = gal::GeneticAlgorithm<gal::PathChromosome>(problem, gaPopulation, 0.05, 0.05, 2);
+        for (int g = 0; g < gaGenerations; g++) ga.nextGeneration();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    double meanEdgeGap(const Graph & graph) {
+        double total = 0;
+        for (unsigned int v = 1; v <= graph.getNodeCount(); v++) {
+            for (auto u : graph.getNeighbours(v)) total += u > v ? u - v : v - u;
+        }
+        return total / static_cast<double>(std::max<std::size_t>(graph.getEntryCount(), 1));
+    }
+
+    // Misses per decode step with the precision of the other columns, "-" without the counter.
+    std::string perStep(const PerfSample & counts, PerfEvent event, std::uint64_t steps) {
+        auto value = counts.per(event, steps);
+        if (std::isnan(value)) return "-";
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(3) << value;
+        return text.str();
+    }
+
+    void benchmark(const std::string & name, const Graph & graph, unsigned int chromosomeCount, int repeats,
+                   const PerfCounters & perf) {
+        std::mt19937 gen(7);
+        const auto chromosomes = walkChromosomes(graph, chromosomeCount, gen);
+        std::cout << name << ": " << graph.getNodeCount() << " nodes, " << graph.getEntryCount() / 2 << " edges"
+                  << std::endl;
+        std::cout << "  order      decode ms   speedup   L1 miss/step  LLC miss/step     GA ms   speedup   edge id gap"
+                  << "   path step id gap" << std::endl;
+
+        std::vector<std::vector<unsigned int>> reference;
+        for (auto & genes : chromosomes) reference.push_back(graph.computePath(genes));
+        double originalDecode = 0, originalGa = 0;
+        for (auto [order, label] : {std::pair(NodeOrder::Original, "none"), std::pair(NodeOrder::Bfs, "bfs"),
+                                    std::pair(NodeOrder::ReverseCuthillMcKee, "rcm"),
+                                    std::pair(NodeOrder::Degree, "degree")}) {
+            auto relabeling = relabelGraph(graph, order);
+            std::vector<std::vector<unsigned int>> relabeled;
+            for (auto & genes : chromosomes) relabeled.push_back(relabeling.relabelGenes(genes));
+
+            // A decode step is a node of the decoded path, as counted by GAL_INSTRUMENT builds.
+            std::uint64_t checksum = 0, decodeSteps = 0;
+            const auto before = perf.read();
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++) {
+                for (auto & genes : relabeled) {
+                    auto path = relabeling.graph.computePath(genes);
+                    checksum += path[0];
+                    decodeSteps += path.size() - 1;
+                }
+            }
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            const auto counts = perf.read() - before;
+            const double decode = elapsed.count() / repeats;
+            const double ga = gaMilliseconds(relabeling.graph);
+            if (order == NodeOrder::Original) {
+                originalDecode = decode;
+                originalGa = ga;
+            }
+
+            // The decoded paths have to be the same paths once mapped back, and the genes the same genes.
+            double steps = 0, stepGap = 0;
+            for (std::size_t c = 0; c < relabeled.size(); c++) {
+                auto path = relabeling.graph.computePath(relabeled[c]);
+                auto restored = relabeling.restore({path[0], {path.begin() + 1, path.end()}});
+                if (!std::equal(restored.nodes.begin(), restored.nodes.end(), reference[c].begin() + 1,
+                                reference[c].end()) || relabeling.restoreGenes(relabeled[c]) != chromosomes[c])
+                    throw std::runtime_error("Relabeled decoding differs from the original decoding.");
+                for (std::size_t i = 2; i < path.size(); i++) {
+                    stepGap += path[i] > path[i - 1] ? path[i] - path[i - 1] : path[i - 1] - path[i];
+                    steps++;
+                }
+            }
+            std::cout << "  " << std::left << std::setw(10) << label << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(10) << decode << std::setw(9) << std::setprecision(2)
+                      << originalDecode / decode << "x" << std::setw(15)
+                      << perStep(counts, PerfEvent::L1Misses, decodeSteps) << std::setw(15)
+                      << perStep(counts, PerfEvent::LlcMisses, decodeSteps) << std::setw(10) << std::setprecision(1)
+                      << ga << std::setw(9)
+                      << std::setprecision(2) << originalGa / ga << "x" << std::setw(14) << std::setprecision(1)
+                      << meanEdgeGap(relabeling.graph) << std::setw(19) << stepGap / std::max(steps, 1.0)
+                      << (checksum == 0 ? " (empty)" : "") << std::endl;
+        }
+    }
+}
+
+int main() {
+    PerfCounters perf;
+    if (!perf.reason().empty()) std::cout << "Missing hardware counters: " << perf.reason() << std::endl;
+    std::mt19937 gen(1);
+    benchmark("Shuffled grid", shuffledGrid(1000, gen), 20, 3, perf);
+    benchmark("Sparse Erdos-Renyi", erdosGraphConnected(1000000, 3.0 / 1000000, 1), 20, 3, perf);
+    return 0;
+}
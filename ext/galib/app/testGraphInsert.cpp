@@ -2,10 +2,18 @@
 // Created by emi on 02/12/2021.
 //
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <random>
+#include <stdexcept>
 #include "../include/graph.h"
 #include "../include/randomGraph.h"
 #include "../include/testGraphs.h"
+#include "../include/graphSnapshot.h"
+#include "../include/threadPool.h"
 
 namespace graph_lib{
     // Code test below
@@ -21,6 +29,23 @@ namespace graph_lib{
         ;
     }
 
+    void testWeightNarrowing(){
+        auto g = graph_lib::Graph(graph_lib::exampleGraph(9), 9);
+        assert(weightsFit<std::uint16_t>(g));
+        auto compact = CompactGraph(g);
+        std::vector<unsigned int> prefs{7, 2, 8, 4, 5, 9, 3, 6, 2, 1};
+        auto path = g.computePath(prefs);
+        auto compactPath = compact.computePath(prefs);
+        assert(std::equal(path.begin(), path.end(), compactPath.begin(), compactPath.end()));
+
+        auto heavy = graph_lib::Graph(EdgeList{{1, 2, 70000}, {2, 3, 1}}, 3);
+        assert(!weightsFit<std::uint16_t>(heavy));
+        bool threw = false;
+        try { CompactGraph compactHeavy(heavy); } catch (const std::invalid_argument &) { threw = true; }
+        assert(threw);
+        assert(parseWeightType("auto") == WeightType::Auto);
+    }
+
     void testConnectedComponents(){
         auto testData = simpleConnComp(7);
         findConnectedComponents(testData, 7);
@@ -31,12 +56,68 @@ namespace graph_lib{
         ;//Breakpoint line to inspect g1 in debug
         auto g2 = erdosGraphRejection(10, 0.1, 4);
         ;//Breakpoint line to inspect g2 in debug
+        auto g3 = erdosGraphConnected(10, 0.1, 4);
+        ;//Breakpoint line to inspect g3 in debug
+    }
+
+    void testSnapshot(){
+        auto g = erdosGraphRecursive(50, 0.05, 1);
+        auto path = (std::filesystem::temp_directory_path() / "testSnapshot.glsnap").string();
+        saveGraphSnapshot(g, path);
+        auto mapped = loadGraphSnapshot(path, true);
+        assert(adjacencyChecksum(g) == adjacencyChecksum(mapped));
+        ;//Breakpoint line to inspect mapped in debug
+        std::filesystem::remove(path);  // The mapping stays valid after the file is removed
+
+        // A neighbour id beyond the node count has to be rejected on load, also without verifying the checksum.
+        saveGraphSnapshot(g, path);
+        {
+            SnapshotHeader header{};
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.read(reinterpret_cast<char *>(&header), sizeof(header));
+            std::uint32_t outOfRange = header.nodeCount + 1;
+            file.seekp(static_cast<std::streamoff>(header.neighboursPos));
+            file.write(reinterpret_cast<const char *>(&outOfRange), sizeof(outOfRange));
+        }
+        bool rejected = false;
+        try {
+            loadGraphSnapshot(path);
+        } catch (const std::runtime_error &) {
+            rejected = true;
+        }
+        assert(rejected);
+        std::filesystem::remove(path);
+    }
+
+    // Many tiny tasks, half of them submitting a child to their own deque for idle workers to steal. Every task has to
+    // run once, and afterwards all workers have to go to sleep instead of spinning on a miscounted queue.
+    void testWorkStealingPool(){
+        WorkStealingPool pool(4);
+        for (int round = 0; round < 20; round++) {
+            std::atomic<int> done{0};
+            const int tasks = 20000;
+            for (int i = 0; i < tasks; i++) {
+                pool.submit([&, i] {
+                    done++;
+                    if (i % 2 == 0) pool.submit([&] { done++; });
+                });
+            }
+            pool.wait();
+            assert(done == tasks + tasks / 2);
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pool.getIdleCount() < pool.getThreadCount() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        assert(pool.getIdleCount() == pool.getThreadCount());
     }
 }
 
 int main() {
     graph_lib::testExampleGraph();
+    graph_lib::testWeightNarrowing();
     graph_lib::testConnectedComponents();
     graph_lib::testErdosGeneration();
+    graph_lib::testSnapshot();
+    graph_lib::testWorkStealingPool();
     return 0;
 };
\ No newline at end of file
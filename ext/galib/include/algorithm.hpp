@@ -16,12 +16,33 @@
 #include <map>
 #include <algorithm>
 #include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <span>
 #include <stdlib.h>
 #include "util.hpp"
 #include "chromosome.hpp"
 #include "problem.hpp"
+#include "generationStats.hpp"
+#include "checkpoint.hpp"
 
 namespace gal {
+    /**
+     * Summary of the population after a generation, cheap enough to compute every generation.
+     */
+    struct GenerationSnapshot {
+        int generation = 0;
+        double best = 0;                // Best objective value in the population
+        double mean = 0;                // Mean objective value
+        double diversity = 0;           // Fraction of distinct objective values, 1 / population size once converged
+        std::size_t bestIndex = 0;      // Index of the best chromosome in GeneticAlgorithm::population()
+    };
+
+    /**
+     * Called after every generation, see GeneticAlgorithm::setObserver().
+     */
+    using GenerationObserver = std::function<void(const GenerationSnapshot &)>;
+
     /**
      * GeneticAlgorithm is the center of an optimisation run: it contains the
      * BitstringChromosome members, the Problem at hand, and evolves the population
@@ -37,6 +58,8 @@ namespace gal {
     template<typename C>
     class GeneticAlgorithm {
     public:
+        using Gene = typename std::decay_t<decltype(std::declval<C>().bits_)>::value_type;
+
         /**
          * Constructs a new GeneticAlgorithm, and initializes the population.
          *
@@ -71,19 +94,130 @@ namespace gal {
          * @see reproduce()
          */
         void nextGeneration() {
+            recorder_.begin(generation() + 1);
             // create new chromosomes, and throw old away
             population_ = reproduce(population_, objectives_, nr_of_elites_);
 
             // randomly distort chromosomes in-place
-            mutate(population_);
+            {
+                GAL_PHASE(recorder_, Phase::Mutation);
+                mutate(population_);
+            }
 
             // recompute the objective values of chromosomes in the population
-            for (int i = 0; i < population_.size(); i++)
-                objectives_[i] = problem_.evaluate(population_[i]);
+            {
+                GAL_PHASE(recorder_, Phase::Evaluation);
+                for (int i = 0; i < population_.size(); i++)
+                    objectives_[i] = problem_.evaluate(population_[i]);
+            }
 
             // log the best value of the current generation
             double max = *std::max_element(objectives_.begin(), objectives_.end());
             generation_max_objectives_.push_back(max);
+            recorder_.end();
+            if (observer_) observer_(snapshot());
+        }
+
+        /**
+         * Calls observer after every following generation, so drivers can log progress without touching the
+         * population. An empty observer stops the calls.
+         */
+        void setObserver(GenerationObserver observer) {
+            observer_ = std::move(observer);
+        }
+
+        /**
+         * Best, mean and diversity of the objective values of the current population. Best and mean take one pass,
+         * diversity sorts a copy of the values in a buffer kept between calls. Only computed for the observer, or on
+         * request.
+         */
+        GenerationSnapshot snapshot() const {
+            GenerationSnapshot snapshot;
+            snapshot.generation = generation();
+            if (objectives_.empty()) return snapshot;
+            double sum = 0;
+            for (std::size_t i = 0; i < objectives_.size(); i++) {
+                sum += objectives_[i];
+                if (objectives_[i] > objectives_[snapshot.bestIndex]) snapshot.bestIndex = i;
+            }
+            snapshot.best = objectives_[snapshot.bestIndex];
+            snapshot.mean = sum / objectives_.size();
+            sorted_objectives_.assign(objectives_.begin(), objectives_.end());
+            std::sort(sorted_objectives_.begin(), sorted_objectives_.end());
+            auto distinct = std::distance(sorted_objectives_.begin(),
+                                          std::unique(sorted_objectives_.begin(), sorted_objectives_.end()));
+            snapshot.diversity = static_cast<double>(distinct) / objectives_.size();
+            return snapshot;
+        }
+
+        /**
+         * Statistics of the last generation: time per phase and decoding work. Only recorded when compiled with
+         * GAL_INSTRUMENT, all 0 otherwise.
+         */
+        const GenerationStats & lastStats() const {
+            return recorder_.stats();
+        }
+
+        /**
+         * Hands the statistics of every following generation to sink, e.g. csvSink(file). Never called without
+         * GAL_INSTRUMENT.
+         */
+        void setStatsSink(StatsSink sink) {
+            recorder_.setSink(std::move(sink));
+        }
+
+        /**
+         * Adds cycles, instructions, cache and branch misses to the statistics, if the system lets us count them.
+         * @see GenerationRecorder::enableHardwareCounters()
+         */
+        bool enableHardwareCounters() {
+            return recorder_.enableHardwareCounters();
+        }
+
+        /**
+         * The state after the last generation, enough to continue exactly as this GeneticAlgorithm would, on the
+         * thread that runs it. Copying the genes is all it costs, writing them is left to e.g. a CheckpointWriter.
+         *
+         * @param fingerprint Identifies what is being optimised, restore() refuses checkpoints of anything else.
+         */
+        Checkpoint<Gene> checkpoint(std::uint64_t fingerprint) const {
+            Checkpoint<Gene> checkpoint;
+            checkpoint.fingerprint = fingerprint;
+            checkpoint.mutationProbability = mutation_probability_;
+            checkpoint.crossoverProbability = crossover_probability_;
+            checkpoint.nrOfElites = nr_of_elites_;
+            checkpoint.genes.reserve(population_.size());
+            for (auto & chromosome : population_) checkpoint.genes.push_back(chromosome.bits_);
+            checkpoint.objectives = objectives_;
+            checkpoint.history = generation_max_objectives_;
+            std::ostringstream engineState;
+            engineState << engine;
+            checkpoint.engineState = engineState.str();
+            checkpoint.problemState = problem_.randomState();
+            return checkpoint;
+        }
+
+        /**
+         * Continues from a checkpoint of a GeneticAlgorithm with the same problem and parameters. The population
+         * built by the constructor is overwritten, and so are the random states of the problem and of this thread.
+         */
+        void restore(const Checkpoint<Gene> & checkpoint, std::uint64_t fingerprint) {
+            if (checkpoint.fingerprint != fingerprint)
+                throw std::invalid_argument("The checkpoint was written for another problem.");
+            if (checkpoint.genes.size() != population_.size() || checkpoint.objectives.size() != population_.size()
+                || checkpoint.mutationProbability != mutation_probability_
+                || checkpoint.crossoverProbability != crossover_probability_
+                || checkpoint.nrOfElites != nr_of_elites_)
+                throw std::invalid_argument("The checkpoint was written with other GA parameters.");
+            for (std::size_t i = 0; i < population_.size(); i++) {
+                population_[i].bits_ = checkpoint.genes[i];
+                population_[i].setElite(false);  // Mutation clears the flags before a generation ends
+            }
+            objectives_ = checkpoint.objectives;
+            generation_max_objectives_ = checkpoint.history;
+            std::istringstream engineState(checkpoint.engineState);
+            engineState >> engine;
+            problem_.setRandomState(checkpoint.problemState);
         }
 
         /**
@@ -93,28 +227,48 @@ namespace gal {
             return generation_max_objectives_.size();
         }
 
+        /**
+         * Index of the current best chromosome in population().
+         */
+        std::size_t optimumIndex() const {
+            return std::distance(objectives_.begin(), std::max_element(objectives_.begin(), objectives_.end()));
+        }
+
         /**
          * Returns the current best chromosome in the population.
          */
-        C optimum() const {
-            auto m = std::max_element(objectives_.begin(), objectives_.end());
-            return population_[std::distance(objectives_.begin(), m)];
+        const C & optimum() const {
+            return population_[optimumIndex()];
         }
 
         /**
-         * Objective values getter
+         * Best objective value of every generation so far
          */
-        std::vector<double> objectiveValues() const {
+        const std::vector<double> & objectiveValues() const {
             return generation_max_objectives_;
         }
 
+        /**
+         * Objective values of the current population, objectives()[i] belongs to population()[i]
+         */
+        std::span<const double> objectives() const {
+            return objectives_;
+        }
+
         /**
          * Population getter
          */
-        std::vector<C> population() const {
+        const std::vector<C> & population() const {
             return population_;
         }
 
+        /**
+         * The first count chromosomes of the population, or all of them if there are fewer
+         */
+        std::span<const C> population(std::size_t count) const {
+            return std::span<const C>(population_).first(std::min(count, population_.size()));
+        }
+
         /**
          * Tests whether the GeneticAlgorithm has converged. Convergence is
          * defined as an unchanged objective value over several generations.
@@ -141,8 +295,13 @@ namespace gal {
         std::vector<C> reproduce(const std::vector<C> &population,
                                  const std::vector<double> &objectives,
                                  const unsigned int nr_of_elites = 0) const {
-            auto population_fitness = fitness(objectives);
-            double total_fitness = std::reduce(population_fitness.begin(), population_fitness.end());
+            std::vector<double> population_fitness;
+            double total_fitness;
+            {
+                GAL_PHASE(recorder_, Phase::Fitness);
+                population_fitness = fitness(objectives);
+                total_fitness = std::reduce(population_fitness.begin(), population_fitness.end());
+            }
             std::vector<C> next_generation;
             next_generation.reserve(population.size());
 
@@ -154,6 +313,7 @@ namespace gal {
 
 
             if (problem_.local_search_) {
+                GAL_PHASE(recorder_, Phase::LocalSearch);
                 for (auto chrom : population)
                     chrom.localSearch();
             }
@@ -166,15 +326,18 @@ namespace gal {
             }
 
 
-            sort(chromo_indices_by_obj.begin(), chromo_indices_by_obj.end(),
-                 [&objectives](int a, int b) {
-                     return (objectives[a] > objectives[b]);
-                 }
-            );
-
             std::vector<C> sorted_population;
-            for(int chromo_index :chromo_indices_by_obj){
-                sorted_population.push_back(population[chromo_index]);
+            {
+                GAL_PHASE(recorder_, Phase::Selection);
+                sort(chromo_indices_by_obj.begin(), chromo_indices_by_obj.end(),
+                     [&objectives](int a, int b) {
+                         return (objectives[a] > objectives[b]);
+                     }
+                );
+
+                for(int chromo_index :chromo_indices_by_obj){
+                    sorted_population.push_back(population[chromo_index]);
+                }
             }
 
             std::vector<C> parents;
@@ -184,6 +347,7 @@ namespace gal {
             unsigned int elite_index = 0;
             // If there are elites, add all of them
             while(elite_index < nr_of_elites && next_generation.size() < population.size()){
+                GAL_PHASE(recorder_, Phase::Selection);
                 // TODO: Allow elites to be parents
                 // TODO: Exempt elites from mutation
 
@@ -193,7 +357,7 @@ namespace gal {
                 next_generation.push_back(sorted_population[elite_index]);
 
                 // Add elite as parent with cross_over_probability_
-                float cross_over_rand = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX));
+                float cross_over_rand = static_cast <float> (random_real());
                 if(cross_over_rand <= crossover_probability_){
                     parents.push_back(population[elite_index]);
                 }
@@ -204,45 +368,51 @@ namespace gal {
 
             while(next_generation.size() < population.size()){
 
-                while(parents.size() < 2 && next_generation.size() < population.size()){
-                    int survivor_index = select(population_fitness, total_fitness);
-
-                    // Add survivor as parent with cross_over_probability_
-                    float cross_over_rand = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX));
-                    if(cross_over_rand <= crossover_probability_){
-                        parents.push_back(population[survivor_index]);
-                    }
-                        // Otherwise add directly to next generation
-                    else{
-                        next_generation.push_back(population[survivor_index]);
+                {
+                    GAL_PHASE(recorder_, Phase::Selection);
+                    while(parents.size() < 2 && next_generation.size() < population.size()){
+                        int survivor_index = select(population_fitness, total_fitness);
+
+                        // Add survivor as parent with cross_over_probability_
+                        float cross_over_rand = static_cast <float> (random_real());
+                        if(cross_over_rand <= crossover_probability_){
+                            parents.push_back(population[survivor_index]);
+                        }
+                            // Otherwise add directly to next generation
+                        else{
+                            next_generation.push_back(population[survivor_index]);
+                        }
                     }
                 }
 
-                while(parents.size() >= 2 && next_generation.size() < population.size()){
-                    // Copy the first parent from end of vector
-                    auto child_a1 = C(parents.back());
-                    // Remove the parent we just copied
-                    parents.pop_back();
-                    // Copy the second parent from end of vector
-                    auto child_a2 = C(parents.back());
-                    // Remove the parent we just copied
-                    parents.pop_back();
-
-                    // Copy both chromosomes for making second child
-                    auto child_b1 = C(child_a1);
-                    auto child_b2 = C(child_a2);
-
-                    // Crossover
-                    child_a1.crossover(child_a2);
-                    // Add child_a to next generation
-                    next_generation.push_back(child_a1);
-
-                    // Check if there is room for second child
-                    if(next_generation.size() < population.size()){
-                        // Get random position between 0 and 15;
-                        child_b1.crossover(child_b2);
-                        // Add child_b to next generation
-                        next_generation.push_back(child_b1);
+                {
+                    GAL_PHASE(recorder_, Phase::Crossover);
+                    while(parents.size() >= 2 && next_generation.size() < population.size()){
+                        // Copy the first parent from end of vector
+                        auto child_a1 = C(parents.back());
+                        // Remove the parent we just copied
+                        parents.pop_back();
+                        // Copy the second parent from end of vector
+                        auto child_a2 = C(parents.back());
+                        // Remove the parent we just copied
+                        parents.pop_back();
+
+                        // Copy both chromosomes for making second child
+                        auto child_b1 = C(child_a1);
+                        auto child_b2 = C(child_a2);
+
+                        // Crossover
+                        child_a1.crossover(child_a2);
+                        // Add child_a to next generation
+                        next_generation.push_back(child_a1);
+
+                        // Check if there is room for second child
+                        if(next_generation.size() < population.size()){
+                            // Get random position between 0 and 15;
+                            child_b1.crossover(child_b2);
+                            // Add child_b to next generation
+                            next_generation.push_back(child_b1);
+                        }
                     }
                 }
 
@@ -328,7 +498,7 @@ namespace gal {
             // element gets a small increase in probability to get picked. (the size of the rounding error difference)
             // This cannot be helped.
             while(true) {
-                float roulette = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / (total_fitness)));
+                float roulette = static_cast <float> (random_real(0.0, total_fitness));
                 float roulette_test = 0;
                 int survivor_index = 0;
 
@@ -351,5 +521,8 @@ namespace gal {
         double mutation_probability_;               // Probability of mutation for bits
         double crossover_probability_;              // Probability of crossover for chromosomes
         int nr_of_elites_;                          // Nr of elites per generation
+        mutable GenerationRecorder recorder_;       // Per generation statistics, see lastStats()
+        GenerationObserver observer_;               // See setObserver()
+        mutable std::vector<double> sorted_objectives_;  // Scratch buffer of snapshot()
     };
 }
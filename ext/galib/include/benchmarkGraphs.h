@@ -0,0 +1,55 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_BENCHMARKGRAPHS_H
+#define LCSCGA_BENCHMARKGRAPHS_H
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include "graph.h"
+
+namespace graph_lib {
+    // Scalable graphs whose longest path is known, for measuring solution quality from hundreds to millions of
+    // nodes. The generators stream their edges to a sink instead of building an EdgeList, so huge instances can be
+    // written out directly. Edges may repeat, like Graph does readers should keep the first occurrence.
+    using EdgeSink = std::function<void(const Edge &)>;
+
+    // Weight of the planted path edges, noise edges weigh 1 .. plantedWeight - 1. Every path has at most nodes - 1
+    // edges, so the planted Hamiltonian path, of length (nodes - 1) * plantedWeight, is a longest path and the only
+    // paths that tie with it are Hamiltonian paths over planted edges.
+    constexpr std::uint32_t plantedWeight = 100;
+
+    // A Hamiltonian path over the nodes in random order, followed by nodes * degree / 2 uniformly random noise edges.
+    void plantedPathEdges(unsigned int nodes, double degree, int seed, const EdgeSink & sink);
+
+    // Unit weight grid width nodes wide, the first row holding the nodes * width remainder. It has a Hamiltonian path:
+    // along the first row towards column 0, down, and then snaking through the full rows. A width of 2 gives a ladder.
+    void gridEdges(unsigned int nodes, unsigned int width, const EdgeSink & sink);
+
+    // Random points in the unit square connected within the distance that gives the mean degree, with noise weights,
+    // plus a planted path visiting the points in strips, so most of its edges are short.
+    void randomGeometricEdges(unsigned int nodes, double degree, int seed, const EdgeSink & sink);
+
+    // Barabasi-Albert preferential attachment (every new node attaches to degree / 2 nodes chosen by degree), a
+    // power-law graph, with noise weights plus a planted path in random order.
+    void barabasiAlbertEdges(unsigned int nodes, double degree, int seed, const EdgeSink & sink);
+
+    /**
+     ** The generators by getGraphByType id, with param2 the mean degree of the noise edges:
+     ** 9: planted path, 10: grid (square as possible), 11: ladder, 12: random geometric, 13: Barabasi-Albert.
+     **/
+    void benchmarkGraphEdges(int type, unsigned int nodes, double param2, int seed, const EdgeSink & sink);
+    EdgeList benchmarkGraphEdges(int type, unsigned int nodes, double param2, int seed);
+    bool isBenchmarkGraphType(int type);
+
+    // Longest path length of a benchmark graph type with this many nodes, empty for other types.
+    std::optional<std::uint64_t> knownOptimum(int type, unsigned int nodes);
+
+    // Writes the edges as text lines "u v w", after a first line with the node count that writeEdgeListHeader writes.
+    void writeEdgeListHeader(std::ostream & out, unsigned int nodes);
+    EdgeSink edgeListWriter(std::ostream & out);
+}
+
+#endif //LCSCGA_BENCHMARKGRAPHS_H
@@ -0,0 +1,42 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_BLOCKS_H
+#define LCSCGA_BLOCKS_H
+
+#include <vector>
+#include "graph.h"
+#include "disjointSet.h"
+
+namespace graph_lib {
+    // The biconnected blocks of a graph. Every edge lies in exactly one block, two blocks share at most one node, and
+    // the shared nodes are the articulation points. Isolated nodes form a block on their own.
+    struct Blocks {
+        Components blocks;
+        std::vector<unsigned int> blockCount;   // Number of blocks every node is in, > 1 for articulation points
+        // The edges of block b are edges[edgeOffsets[b]] .. edges[edgeOffsets[b+1]-1].
+        std::vector<std::size_t> edgeOffsets;
+        EdgeList edges;
+
+        bool isArticulation(unsigned int node) const { return blockCount[node] > 1; }
+        std::span<const Edge> getEdges(std::size_t b) const {
+            return {edges.data() + edgeOffsets[b], edges.data() + edgeOffsets[b + 1]};
+        }
+    };
+
+    // The block-cut tree (a forest for disconnected graphs) joins every block to the articulation points it contains.
+    // A simple path can only move from one block to the next through such an articulation point, and never comes back
+    // to a block it left.
+    struct BlockCutTree {
+        Components cuts;        // The articulation points of every block
+        Components blocksAt;    // The blocks every node is in, by node id (group 0 is empty)
+    };
+
+    // Tarjan's algorithm with an explicit stack instead of recursion, so path-like graphs with millions of nodes do
+    // not overflow the call stack. O(nodes + edges).
+    Blocks biconnectedComponents(const Graph & graph);
+
+    BlockCutTree blockCutTree(const Blocks & blocks);
+}
+
+#endif //LCSCGA_BLOCKS_H
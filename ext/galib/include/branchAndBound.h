@@ -0,0 +1,51 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_BRANCHANDBOUND_H
+#define LCSCGA_BRANCHANDBOUND_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include "exactSolver.h"
+
+namespace graph_lib {
+    // State of a branch and bound search. The optimum lies between incumbent and bound, and is proven once they meet.
+    struct BranchAndBoundProgress {
+        std::uint64_t incumbent;
+        std::uint64_t bound;
+        std::uint64_t nodesExplored;
+        double seconds;
+
+        // Relative distance between the incumbent and the bound, 0 once the incumbent is proven optimal.
+        double getGap() const {
+            return bound == 0 ? 0.0 : static_cast<double>(bound - incumbent) / static_cast<double>(bound);
+        }
+    };
+
+    struct BranchAndBoundResult {
+        PathSolution best;
+        BranchAndBoundProgress progress;
+        bool optimal;
+    };
+
+    struct BranchAndBoundOptions {
+        unsigned int threads = 0;                                   // 0 for all cores
+        std::chrono::milliseconds timeLimit{0};                     // 0 for no limit
+        std::chrono::milliseconds reportInterval{1000};
+        std::function<void(const BranchAndBoundProgress &)> report; // called every reportInterval, if set
+    };
+
+    /**
+     ** Exact longest simple path by depth first branch and bound, for graphs too large for longestPathDp.
+     ** Visited sets are bitsets, and a partial path ending in v is cut off once its length plus the heaviest edge of
+     ** every node still reachable from v (without crossing the path) cannot beat the incumbent. Subtrees are split off
+     ** into tasks on a work stealing pool while there are idle workers.
+     ** initial seeds the incumbent, e.g. with the path of the GA's best chromosome. When the time limit runs out the
+     ** best path found so far is returned together with a certified bound.
+     **/
+    BranchAndBoundResult longestPathBranchAndBound(const Graph & graph, const PathSolution & initial = {},
+                                                   const BranchAndBoundOptions & options = {});
+}
+
+#endif //LCSCGA_BRANCHANDBOUND_H
@@ -0,0 +1,180 @@
+/**
+ * @file checkpoint.hpp
+ *
+ * Contains gal::Checkpoint, everything needed to continue a GeneticAlgorithm exactly where it stopped, its binary
+ * file format, and gal::CheckpointWriter, which writes checkpoints on a background thread.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace gal {
+    // Bump this whenever the layout below changes, older checkpoints will then be rejected on load.
+    constexpr std::uint32_t checkpointVersion = 1;
+
+    /**
+     * The state of a GeneticAlgorithm after a generation, see GeneticAlgorithm::checkpoint() and restore().
+     *
+     * @tparam T The gene type of the chromosomes.
+     */
+    template<typename T>
+    struct Checkpoint {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoints store genes as raw bytes.");
+
+        std::uint64_t fingerprint = 0;          // Chosen by the caller, e.g. a hash of the graph and parameters
+        double mutationProbability = 0;
+        double crossoverProbability = 0;
+        std::int32_t nrOfElites = 0;
+        std::vector<std::vector<T>> genes;      // The genes of every chromosome of the population
+        std::vector<double> objectives;         // Objective value of every chromosome
+        std::vector<double> history;            // Best objective of every generation so far
+        std::string engineState;                // The engine behind random_int and random_real
+        std::string problemState;               // See Problem::randomState()
+    };
+
+    namespace detail {
+        constexpr char checkpointMagic[8] = {'G', 'A', 'L', 'C', 'K', 'P', 'T', 0};
+
+        template<typename V>
+        void writeValue(std::ostream & out, const V & value) {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        template<typename V>
+        void writeArray(std::ostream & out, const V * data, std::uint64_t count) {
+            writeValue(out, count);
+            out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(V)));
+        }
+
+        template<typename V>
+        V readValue(std::istream & in) {
+            V value{};
+            in.read(reinterpret_cast<char *>(&value), sizeof(value));
+            return value;
+        }
+
+        // Reads what writeArray wrote. maxCount guards against allocating a corrupt count.
+        template<typename V>
+        std::vector<V> readArray(std::istream & in, std::uint64_t maxCount) {
+            auto count = readValue<std::uint64_t>(in);
+            if (!in || count > maxCount) throw std::runtime_error("Checkpoint is truncated or corrupt.");
+            std::vector<V> values(count);
+            in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(count * sizeof(V)));
+            return values;
+        }
+    }
+
+    /**
+     * Writes checkpoint to filename: a header, the GA parameters and then the arrays, each prefixed with its length.
+     * The file is written under a temporary name first and renamed, so an interrupted write leaves the previous
+     * checkpoint intact.
+     */
+    template<typename T>
+    void writeCheckpoint(const Checkpoint<T> & checkpoint, const std::string & filename) {
+        auto temporary = filename + ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Could not open " + temporary + " for writing.");
+            out.write(detail::checkpointMagic, sizeof(detail::checkpointMagic));
+            detail::writeValue(out, checkpointVersion);
+            detail::writeValue(out, static_cast<std::uint32_t>(sizeof(T)));
+            detail::writeValue(out, checkpoint.fingerprint);
+            detail::writeValue(out, checkpoint.mutationProbability);
+            detail::writeValue(out, checkpoint.crossoverProbability);
+            detail::writeValue(out, checkpoint.nrOfElites);
+            detail::writeValue(out, static_cast<std::uint64_t>(checkpoint.genes.size()));
+            for (auto & genes : checkpoint.genes) detail::writeArray(out, genes.data(), genes.size());
+            detail::writeArray(out, checkpoint.objectives.data(), checkpoint.objectives.size());
+            detail::writeArray(out, checkpoint.history.data(), checkpoint.history.size());
+            detail::writeArray(out, checkpoint.engineState.data(), checkpoint.engineState.size());
+            detail::writeArray(out, checkpoint.problemState.data(), checkpoint.problemState.size());
+            if (!out) throw std::runtime_error("Could not write checkpoint " + temporary + ".");
+        }
+        std::filesystem::rename(temporary, filename);
+    }
+
+    /**
+     * Reads a checkpoint written by writeCheckpoint.
+     */
+    template<typename T>
+    Checkpoint<T> readCheckpoint(const std::string & filename) {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in) throw std::runtime_error("Could not open checkpoint " + filename + ".");
+        const auto size = std::filesystem::file_size(filename);
+        char magic[sizeof(detail::checkpointMagic)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, detail::checkpointMagic, sizeof(magic)) != 0)
+            throw std::runtime_error(filename + " is not a checkpoint.");
+        auto version = detail::readValue<std::uint32_t>(in);
+        if (version != checkpointVersion)
+            throw std::runtime_error("Checkpoint " + filename + " has version " + std::to_string(version)
+                                     + ", expected " + std::to_string(checkpointVersion) + ".");
+        if (detail::readValue<std::uint32_t>(in) != sizeof(T))
+            throw std::runtime_error("Checkpoint " + filename + " holds genes of another type.");
+
+        Checkpoint<T> checkpoint;
+        checkpoint.fingerprint = detail::readValue<std::uint64_t>(in);
+        checkpoint.mutationProbability = detail::readValue<double>(in);
+        checkpoint.crossoverProbability = detail::readValue<double>(in);
+        checkpoint.nrOfElites = detail::readValue<std::int32_t>(in);
+        auto populationSize = detail::readValue<std::uint64_t>(in);
+        if (!in || populationSize > size) throw std::runtime_error("Checkpoint " + filename + " is corrupt.");
+        checkpoint.genes.resize(populationSize);
+        for (auto & genes : checkpoint.genes) genes = detail::readArray<T>(in, size / sizeof(T));
+        checkpoint.objectives = detail::readArray<double>(in, size / sizeof(double));
+        checkpoint.history = detail::readArray<double>(in, size / sizeof(double));
+        auto engineState = detail::readArray<char>(in, size);
+        auto problemState = detail::readArray<char>(in, size);
+        if (!in) throw std::runtime_error("Checkpoint " + filename + " is truncated.");
+        checkpoint.engineState.assign(engineState.begin(), engineState.end());
+        checkpoint.problemState.assign(problemState.begin(), problemState.end());
+        return checkpoint;
+    }
+
+    /**
+     * Writes checkpoints to a file on a background thread, so generations go on while the file is written. A write
+     * waits for the previous one to finish, and so does the destructor. Errors of a write are thrown by the next
+     * write() or by wait().
+     */
+    template<typename T>
+    class CheckpointWriter {
+    public:
+        explicit CheckpointWriter(std::string filename) : filename_(std::move(filename)) {}
+
+        CheckpointWriter(const CheckpointWriter &) = delete;
+        CheckpointWriter & operator=(const CheckpointWriter &) = delete;
+
+        ~CheckpointWriter() {
+            if (pending_.valid()) pending_.wait();
+        }
+
+        void write(Checkpoint<T> checkpoint) {
+            wait();
+            pending_ = std::async(std::launch::async, [this, checkpoint = std::move(checkpoint)] {
+                writeCheckpoint(checkpoint, filename_);
+            });
+        }
+
+        /**
+         * Blocks until the last checkpoint is on disk.
+         */
+        void wait() {
+            if (pending_.valid()) pending_.get();
+        }
+
+        const std::string & filename() const { return filename_; }
+
+    private:
+        std::string filename_;
+        std::future<void> pending_;
+    };
+}
@@ -50,7 +50,7 @@ namespace gal {
 
             for(auto it = bits_.begin(); it != bits_.end(); it++){
                 // Generate a random double in [0.0, 1.0]
-                double mutation_roll = static_cast <double> (rand()) / (static_cast <double> (RAND_MAX));
+                double mutation_roll = random_real();
                 // Determine if we mutate this bit
                 if(mutation_roll <= probability){
                     // Flip the bit between 0 and 1
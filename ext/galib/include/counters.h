@@ -0,0 +1,36 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_COUNTERS_H
+#define LCSCGA_COUNTERS_H
+
+#include <cstdint>
+
+namespace graph_lib {
+    // Work done by the calling thread. Only counted when built with GAL_INSTRUMENT (cmake -DGAL_INSTRUMENT=ON),
+    // otherwise GRAPH_LIB_COUNT compiles to nothing and these stay 0.
+    struct WorkCounters {
+        std::uint64_t decodes = 0;      // computePath, computePathLength and computeRepairedPath calls
+        std::uint64_t decodeSteps = 0;  // Nodes visited while decoding
+        std::uint64_t edgeLookups = 0;  // getEdge calls, edge tests while decoding and neighbours tried by repairs
+        std::uint64_t allocations = 0;  // operator new calls
+
+        WorkCounters operator-(const WorkCounters & other) const {
+            return {decodes - other.decodes, decodeSteps - other.decodeSteps, edgeLookups - other.edgeLookups,
+                    allocations - other.allocations};
+        }
+    };
+
+    inline WorkCounters & workCounters() {
+        thread_local WorkCounters counters;
+        return counters;
+    }
+}
+
+#ifdef GAL_INSTRUMENT
+#define GRAPH_LIB_COUNT(counter, n) (graph_lib::workCounters().counter += (n))
+#else
+#define GRAPH_LIB_COUNT(counter, n) ((void)0)
+#endif
+
+#endif //LCSCGA_COUNTERS_H
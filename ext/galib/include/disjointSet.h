@@ -0,0 +1,43 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_DISJOINTSET_H
+#define LCSCGA_DISJOINTSET_H
+
+#include <vector>
+#include <span>
+
+namespace graph_lib {
+    // Groups of nodes stored flat: group c consists of nodes[offsets[c]] .. nodes[offsets[c+1]-1], in ascending
+    // order. Connected components partition the nodes, biconnected blocks (see blocks.h) share articulation points.
+    struct Components {
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> nodes;
+
+        std::size_t size() const { return offsets.size() - 1; }
+        std::span<const unsigned int> operator[](std::size_t c) const {
+            return {nodes.data() + offsets[c], nodes.data() + offsets[c + 1]};
+        }
+    };
+
+    // Union-find over the elements 0..size-1, with path compression and union by size. Both operations run in
+    // amortised near constant time.
+    class DisjointSet {
+    public:
+        explicit DisjointSet(unsigned int size);
+        unsigned int find(unsigned int x);
+        // Merges the sets containing a and b, returns false if they already were the same set.
+        bool unite(unsigned int a, unsigned int b);
+        unsigned int getSetSize(unsigned int x);
+        unsigned int getSetCount() const;
+        // The sets of the elements first..size-1, ordered by their smallest element. Our graphs are 1-indexed, so
+        // those pass first = 1 to leave out the unused node 0.
+        Components getComponents(unsigned int first = 0);
+    private:
+        std::vector<unsigned int> parent;
+        std::vector<unsigned int> setSize;
+        unsigned int setCount;
+    };
+}
+
+#endif //LCSCGA_DISJOINTSET_H
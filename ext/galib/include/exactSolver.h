@@ -0,0 +1,36 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_EXACTSOLVER_H
+#define LCSCGA_EXACTSOLVER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "graph.h"
+
+namespace graph_lib {
+    // A simple path and its total weight.
+    struct PathSolution {
+        std::uint64_t length = 0;
+        std::vector<unsigned int> nodes;
+
+        // Formats like the path half of PathChromosome::getText(), "[length | n1, n2, ...]".
+        std::string getText() const;
+    };
+
+    // The subset DP below uses 32 bit node masks, and needs memory exponential in the number of nodes anyway.
+    constexpr unsigned int exactDpMaxNodes = 30;
+
+    /**
+     ** Exact longest simple path by dynamic programming over (visited set, endpoint), Held-Karp style. The table only
+     ** has entries for endpoints inside their set, packed per subset size by the rank of the set, and stores the values
+     ** in 16 bits whenever the weights allow it. Subsets of the same size are filled in parallel.
+     ** Needs O(n 2^n) memory and O(n 2^n deg) time; throws std::invalid_argument if the graph has more than
+     ** exactDpMaxNodes nodes or the table would not fit in memoryLimit bytes.
+     **/
+    PathSolution longestPathDp(const Graph & graph, unsigned int threads = 0,
+                               std::size_t memoryLimit = std::size_t(2) << 30);
+}
+
+#endif //LCSCGA_EXACTSOLVER_H
@@ -0,0 +1,239 @@
+/**
+ * @file generationStats.hpp
+ *
+ * Contains gal::GenerationStats, the time spent in each phase of a generation and the decoding work it did, and
+ * gal::GenerationRecorder, which fills it in for the GeneticAlgorithm.
+ *
+ * Everything is recorded only when compiled with GAL_INSTRUMENT defined (cmake -DGAL_INSTRUMENT=ON). Otherwise the
+ * timers and counters compile to nothing, the statistics stay 0 and no sink is ever called. Hardware counters are
+ * read on top of that once enabled with GenerationRecorder::enableHardwareCounters().
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include "counters.h"
+#include "perfCounters.h"
+
+namespace gal {
+    /**
+     * The phases of a generation, in the order they run.
+     */
+    enum class Phase {
+        Fitness, LocalSearch, Selection, Crossover, Mutation, Evaluation
+    };
+
+    constexpr std::size_t phaseCount = 6;
+    constexpr std::array<const char *, phaseCount> phaseNames = {
+            "fitness", "local_search", "selection", "crossover", "mutation", "evaluation"};
+
+    /**
+     * Wall clock and CPU time of the calling thread, in seconds, and hardware counters if enabled (-1 otherwise).
+     */
+    struct PhaseTime {
+        double wall = 0;
+        double cpu = 0;
+        graph_lib::PerfSample hardware;
+
+        /**
+         * Adds the time and counts from start to end.
+         */
+        void add(const PhaseTime & start, const PhaseTime & end) {
+            wall += end.wall - start.wall;
+            cpu += end.cpu - start.cpu;
+            auto counted = end.hardware - start.hardware;
+            for (std::size_t i = 0; i < graph_lib::perfEventCount; i++) {
+                if (counted.values[i] >= 0) hardware.values[i] = std::max<std::int64_t>(hardware.values[i], 0)
+                                                                 + counted.values[i];
+            }
+        }
+    };
+
+    /**
+     * Statistics of a single generation.
+     */
+    struct GenerationStats {
+        int generation = 0;
+        std::array<PhaseTime, phaseCount> phases{};
+        PhaseTime total;                // The whole of nextGeneration(), including the untimed bookkeeping
+        graph_lib::WorkCounters work;   // Decoding work and allocations during the generation
+
+        PhaseTime & operator[](Phase phase) { return phases[static_cast<std::size_t>(phase)]; }
+        const PhaseTime & operator[](Phase phase) const { return phases[static_cast<std::size_t>(phase)]; }
+
+        /**
+         * Writes the column names matching writeCsv().
+         */
+        static void writeCsvHeader(std::ostream & out) {
+            auto columns = [&](const char * name) {
+                out << ',' << name << "_wall," << name << "_cpu";
+                for (auto event : graph_lib::perfEventNames) out << ',' << name << '_' << event;
+            };
+            out << "generation";
+            for (auto name : phaseNames) columns(name);
+            columns("total");
+            out << ",decodes,decode_steps,edge_lookups,allocations\n";
+        }
+
+        /**
+         * Writes a CSV row, leaving hardware counts that were not read empty.
+         */
+        void writeCsv(std::ostream & out) const {
+            auto columns = [&](const PhaseTime & t) {
+                out << ',' << t.wall << ',' << t.cpu;
+                for (auto value : t.hardware.values) {
+                    out << ',';
+                    if (value >= 0) out << value;
+                }
+            };
+            out << generation;
+            for (auto & phase : phases) columns(phase);
+            columns(total);
+            out << ',' << work.decodes << ',' << work.decodeSteps << ',' << work.edgeLookups << ','
+                << work.allocations << '\n';
+        }
+
+        /**
+         * Writes the statistics as a JSON object on a single line.
+         */
+        void writeJson(std::ostream & out) const {
+            auto time = [&](const PhaseTime & t) {
+                out << "{\"wall\":" << t.wall << ",\"cpu\":" << t.cpu;
+                for (std::size_t i = 0; i < graph_lib::perfEventCount; i++) {
+                    if (t.hardware.values[i] >= 0)
+                        out << ",\"" << graph_lib::perfEventNames[i] << "\":" << t.hardware.values[i];
+                }
+                out << '}';
+            };
+            out << "{\"generation\":" << generation << ",\"phases\":{";
+            for (std::size_t i = 0; i < phaseCount; i++) {
+                out << (i ? ",\"" : "\"") << phaseNames[i] << "\":";
+                time(phases[i]);
+            }
+            out << "},\"total\":";
+            time(total);
+            out << ",\"decodes\":" << work.decodes << ",\"decode_steps\":" << work.decodeSteps
+                << ",\"edge_lookups\":" << work.edgeLookups << ",\"allocations\":" << work.allocations << "}\n";
+        }
+    };
+
+    /**
+     * Receives the statistics of every generation.
+     */
+    using StatsSink = std::function<void(const GenerationStats &)>;
+
+    /**
+     * A sink writing CSV rows to out, starting with the header. out has to outlive the sink.
+     */
+    inline StatsSink csvSink(std::ostream & out) {
+        GenerationStats::writeCsvHeader(out);
+        return [&out](const GenerationStats & stats) { stats.writeCsv(out); };
+    }
+
+    /**
+     * A sink writing one JSON object per line to out. out has to outlive the sink.
+     */
+    inline StatsSink jsonSink(std::ostream & out) {
+        return [&out](const GenerationStats & stats) { stats.writeJson(out); };
+    }
+
+    /**
+     * Reads the wall clock, the CPU time of the calling thread and the hardware counters if given.
+     */
+    inline PhaseTime readClocks(const graph_lib::PerfCounters * perf = nullptr) {
+        timespec cpu{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+        auto wall = std::chrono::steady_clock::now().time_since_epoch();
+        return {std::chrono::duration<double>(wall).count(), static_cast<double>(cpu.tv_sec) + cpu.tv_nsec * 1e-9,
+                perf ? perf->read() : graph_lib::PerfSample{}};
+    }
+
+    /**
+     * Collects the statistics of the generation between begin() and end(), and hands them to the sink.
+     */
+    class GenerationRecorder {
+    public:
+        void begin([[maybe_unused]] int generation) {
+#ifdef GAL_INSTRUMENT
+            stats_ = GenerationStats{};
+            stats_.generation = generation;
+            start_ = readClocks(perf_.get());
+            work_ = graph_lib::workCounters();
+#endif
+        }
+
+        void end() {
+#ifdef GAL_INSTRUMENT
+            stats_.total.add(start_, readClocks(perf_.get()));
+            stats_.work = graph_lib::workCounters() - work_;
+            if (sink_) sink_(stats_);
+#endif
+        }
+
+        /**
+         * Also reads cycles, instructions, cache and branch misses per phase. Returns whether any of them can be
+         * counted, see graph_lib::PerfCounters::reason() otherwise. Always false without GAL_INSTRUMENT.
+         */
+        bool enableHardwareCounters() {
+#ifdef GAL_INSTRUMENT
+            perf_ = std::make_shared<graph_lib::PerfCounters>();
+            if (perf_->available()) return true;
+            perf_.reset();
+#endif
+            return false;
+        }
+
+        GenerationStats & stats() { return stats_; }
+        const GenerationStats & stats() const { return stats_; }
+        const graph_lib::PerfCounters * perf() const { return perf_.get(); }
+        void setSink(StatsSink sink) { sink_ = std::move(sink); }
+
+    private:
+        GenerationStats stats_;
+        StatsSink sink_;
+        std::shared_ptr<graph_lib::PerfCounters> perf_;
+#ifdef GAL_INSTRUMENT
+        PhaseTime start_;
+        graph_lib::WorkCounters work_;
+#endif
+    };
+
+    /**
+     * Adds the time (and hardware counts) from its construction to its destruction to a phase of the recorder.
+     */
+    class PhaseTimer {
+    public:
+        PhaseTimer(GenerationRecorder & recorder, Phase phase)
+            : recorder_(recorder), phase_(phase), start_(readClocks(recorder.perf())) {}
+
+        ~PhaseTimer() {
+            recorder_.stats()[phase_].add(start_, readClocks(recorder_.perf()));
+        }
+
+        PhaseTimer(const PhaseTimer &) = delete;
+        PhaseTimer & operator=(const PhaseTimer &) = delete;
+
+    private:
+        GenerationRecorder & recorder_;
+        Phase phase_;
+        PhaseTime start_;
+    };
+}
+
+#define GAL_CONCAT_IMPL(a, b) a##b
+#define GAL_CONCAT(a, b) GAL_CONCAT_IMPL(a, b)
+
+/**
+ * Times the rest of the enclosing scope as the given phase of a GenerationRecorder, or nothing without GAL_INSTRUMENT.
+ */
+#ifdef GAL_INSTRUMENT
+#define GAL_PHASE(recorder, phase) gal::PhaseTimer GAL_CONCAT(gal_phase_timer_, __LINE__)((recorder), (phase))
+#else
+#define GAL_PHASE(recorder, phase) ((void)0)
+#endif
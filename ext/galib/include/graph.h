@@ -7,25 +7,196 @@
 #include <vector>
 #include <unordered_map>
 #include <random>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <type_traits>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace graph_lib{
-    void sortInput(std::vector<std::vector<unsigned int>> & input);
+    // An undirected edge {u, v} with weight w, as produced by the generators. Edge lists are flat vectors of these, so
+    // building a graph does not need a heap allocation per edge.
+    template <typename W>
+    struct BasicEdge {
+        std::uint32_t u;
+        std::uint32_t v;
+        W w;
+    };
+    using Edge = BasicEdge<std::uint32_t>;
+    using EdgeList = std::vector<Edge>;
+
+    // Converts the older {i, j, w} per line input format.
+    EdgeList toEdgeList(const std::vector<std::vector<unsigned int>> & input);
+
+    // The adjacency of a graph in compressed sparse row form: the neighbours of node i are
+    // neighbours[offsets[i]] .. neighbours[offsets[i+1]-1], sorted ascending, and weights holds the matching edge
+    // weights at the same positions. Offsets has nodeCount+2 entries since our nodes are 1-indexed.
+    // When every edge weighs the same (e.g. after oneify), only the topology is stored: weights is null and every edge
+    // weighs uniformWeight.
+    template <typename W>
+    struct BasicAdjacency {
+        const std::uint32_t * offsets;
+        const std::uint32_t * neighbours;
+        const W * weights;
+        W uniformWeight = 0;
+    };
+    using Adjacency = BasicAdjacency<std::int32_t>;
+
+    // How a preference vector becomes a path: computePath stops at the first visited or missing preference,
+    // computeRepairedPath goes on to another unvisited neighbour, and optionally also grows the path backward.
+    enum class PathDecoder {
+        Stop,
+        Repair,
+        RepairBothWays
+    };
+
+    // Parses "stop", "repair" or "both", as used in the ini files.
+    PathDecoder parsePathDecoder(const std::string & name);
 
-    class Graph{
+    // Reusable scratch space for BasicGraph::computeRepairedPath. Visited nodes are marked with the current epoch, so
+    // the marks never need to be cleared between decodes.
+    struct DecodeBuffer {
+        std::vector<std::uint32_t> visited;
+        std::uint32_t epoch = 0;
+        std::vector<unsigned int> forward;
+        std::vector<unsigned int> backward;
+        std::vector<unsigned int> path;     // The last decoded path
+    };
+
+    /**
+     ** A graph with edge weights of type W, whose path lengths are summed in L. Graph is the default every solver
+     ** works on. The narrower and real valued variants below are for decoding: CompactGraph halves the weights of huge
+     ** graphs and RealGraph takes real valued costs. Only the instantiations below exist (see graph.cpp).
+     **/
+    template <typename W, typename L>
+    class BasicGraph{
     public:
-        Graph(std::vector<std::vector<unsigned int>> & input, unsigned int nodes);
+        using Weight = W;
+        using Length = L;
+        // getEdge's result: the weight, widened to at least int so that -1 can mark a missing edge.
+        using EdgeWeight = std::common_type_t<W, int>;
+
+        // Throws std::invalid_argument when a weight does not fit W.
+        BasicGraph(const EdgeList & input, unsigned int nodes);
+        BasicGraph(const std::vector<BasicEdge<W>> & input, unsigned int nodes);
+        BasicGraph(const std::vector<std::vector<unsigned int>> & input, unsigned int nodes);
+        // Wraps adjacency arrays that live inside owner (e.g. a mapped snapshot file). All copies of this graph share
+        // the same arrays and keep the owner alive.
+        BasicGraph(unsigned int nodes, BasicAdjacency<W> adjacency, std::shared_ptr<const void> owner);
+        // The same graph with its weights converted to W, sharing the offsets and neighbours of other. Throws
+        // std::invalid_argument when a weight does not fit W.
+        template <typename W2, typename L2>
+        explicit BasicGraph(const BasicGraph<W2, L2> & other);
+
+        // path[0] is the length (narrowed to unsigned int, exact for Graph), followed by the nodes of the path.
+        // Path lengths are hop counts times the uniform weight on graphs without a weights array, see Adjacency.
         std::vector<unsigned int> computePath(const std::vector<unsigned int> & prefs) const;
-        int getEdge(unsigned int i, unsigned int j) const;
+        // The exact length of the path computePath decodes, without building the path.
+        L computePathLength(const std::vector<unsigned int> & prefs) const;
+        // Like computePath, but where that stops at a visited or missing preference this goes on to the next unvisited
+        // neighbour in row order after the preferred one. With extendBackward the path also grows backward from the
+        // start, first to neighbours that prefer the current end. The path is left in buffer.path, and nothing is
+        // allocated once buffer has grown to the size of the graph.
+        L computeRepairedPath(const std::vector<unsigned int> & prefs, DecodeBuffer & buffer,
+                              bool extendBackward) const;
+        EdgeWeight getEdge(unsigned int i, unsigned int j) const;
+        // Turns this into a graph without a weights array where every edge weighs 1, sharing the other arrays.
         void oneify();
+        bool hasUniformWeights() const;
         unsigned int getRandomEdge(unsigned int i, std::mt19937 & gen) const;
-        std::unordered_map<unsigned int, int> getNodeEdgeSet(unsigned int i) const;
+        std::unordered_map<unsigned int, W> getNodeEdgeSet(unsigned int i) const;
+        std::span<const std::uint32_t> getNeighbours(unsigned int i) const;
+        std::span<const W> getWeights(unsigned int i) const;
+        unsigned int getDegree(unsigned int i) const;
         unsigned int getNodeCount() const;
+        std::size_t getEntryCount() const;
+        const BasicAdjacency<W> & getAdjacency() const;
     private:
-        std::vector<std::unordered_map<unsigned int, int>> edges;
+        template <typename, typename> friend class BasicGraph;
+
+        std::shared_ptr<const void> owner;
+        BasicAdjacency<W> edges;
         unsigned int nodeCount;
+        // For uniform graphs: the uniform weight repeated for the largest degree, so getWeights can hand out a row.
+        std::shared_ptr<const std::vector<W>> uniformRow;
+
+        template <typename E>
+        void build(const std::vector<BasicEdge<E>> & input, unsigned int nodes);
+        void makeUniform(W weight);
+        // Decodes prefs, appending the nodes to path when it is not null.
+        L decode(const std::vector<unsigned int> & prefs, std::vector<unsigned int> * path) const;
     };
 
+    using Graph = BasicGraph<std::int32_t, unsigned int>;
+    using CompactGraph = BasicGraph<std::uint16_t, std::uint64_t>;
+    using FloatGraph = BasicGraph<float, double>;
+    using RealGraph = BasicGraph<double, double>;
+
+    // The graph type a driver searches: Graph, CompactGraph, or CompactGraph whenever every weight fits it.
+    enum class WeightType {
+        Int,
+        Compact,
+        Auto
+    };
+
+    // Parses "int", "compact" or "auto", as used in the ini files.
+    WeightType parseWeightType(const std::string & name);
+
+    // Whether weight is representable as W, up to rounding for floating point W.
+    template <typename W, typename From>
+    bool weightFits(From weight) {
+        if constexpr (std::is_integral_v<W> && std::is_integral_v<From>) {
+            return std::in_range<W>(weight);
+        } else if constexpr (std::is_integral_v<W>) {
+            return static_cast<double>(weight) >= static_cast<double>(std::numeric_limits<W>::min())
+                   && static_cast<double>(weight) <= static_cast<double>(std::numeric_limits<W>::max());
+        }
+        return true;
+    }
+
+    // Converts a weight to W, throwing std::invalid_argument when it does not fit.
+    template <typename W, typename From>
+    W narrowWeight(From weight) {
+        if (!weightFits<W>(weight))
+            throw std::invalid_argument("Edge weight " + std::to_string(weight) + " does not fit the weight type.");
+        return static_cast<W>(weight);
+    }
+
+    // Whether every edge weight of graph fits W, i.e. whether BasicGraph<W, L>(graph) succeeds.
+    template <typename W, typename W2, typename L2>
+    bool weightsFit(const BasicGraph<W2, L2> & graph) {
+        const auto & adjacency = graph.getAdjacency();
+        if (!adjacency.weights) return weightFits<W>(adjacency.uniformWeight);
+        for (std::size_t k = 0; k < graph.getEntryCount(); k++)
+            if (!weightFits<W>(adjacency.weights[k])) return false;
+        return true;
+    }
 
+    template <typename W, typename L>
+    template <typename W2, typename L2>
+    BasicGraph<W, L>::BasicGraph(const BasicGraph<W2, L2> & other)
+        : owner(other.owner), nodeCount(other.nodeCount) {
+        edges = {other.edges.offsets, other.edges.neighbours, nullptr, 0};
+        if (!other.edges.weights) {
+            makeUniform(narrowWeight<W>(other.edges.uniformWeight));
+            return;
+        }
+        // The new weights live next to a reference to the old owner, which keeps the shared arrays alive.
+        struct Store {
+            std::shared_ptr<const void> shared;
+            std::vector<W> weights;
+        };
+        auto store = std::make_shared<Store>();
+        store->shared = owner;
+        store->weights.reserve(other.getEntryCount());
+        for (std::size_t k = 0; k < other.getEntryCount(); k++)
+            store->weights.push_back(narrowWeight<W>(other.edges.weights[k]));
+        edges.weights = store->weights.data();
+        owner = std::move(store);
+    }
 }
 
 #endif //LCSCGA_GRAPH_H
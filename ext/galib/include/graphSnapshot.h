@@ -0,0 +1,52 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_GRAPHSNAPSHOT_H
+#define LCSCGA_GRAPHSNAPSHOT_H
+
+#include <string>
+#include <cstdint>
+#include "graph.h"
+
+namespace graph_lib {
+    // Bump this whenever the layout below changes, older snapshots will then be rejected on load.
+    constexpr std::uint32_t snapshotVersion = 2;
+
+    /**
+     ** Binary graph snapshot. The file is the header followed by the offsets, neighbours and weights arrays of the
+     ** graph's Adjacency, each starting at a 64 byte aligned position, where graphs with uniform weights leave out the
+     ** weights. Loading maps the file read-only and points the graph straight into it, so no parsing happens and all
+     ** processes loading the same file share the same pages.
+     **/
+    struct SnapshotHeader {
+        char magic[8];                  // "GLSNAP" padded with zeroes
+        std::uint32_t version;          // snapshotVersion at time of writing
+        std::uint32_t nodeCount;
+        std::uint64_t entryCount;       // Adjacency entries, every undirected edge is stored twice
+        std::uint64_t offsetsPos;       // Byte positions of the three arrays in the file
+        std::uint64_t neighboursPos;
+        std::uint64_t weightsPos;       // 0 when the weights array is left out
+        std::uint64_t fileSize;
+        std::uint64_t checksum;         // adjacencyChecksum of the arrays
+        std::int32_t uniformWeight;     // The weight of every edge when the weights array is left out
+        std::uint32_t padding;
+    };
+
+    // Hash over the adjacency arrays of a graph, equal graphs (same nodes, edges and weights) hash equal.
+    std::uint64_t adjacencyChecksum(const Graph & graph);
+
+    // Writes graph to filename. The file is written under a temporary name first, so concurrent readers never see a
+    // half written snapshot.
+    void saveGraphSnapshot(const Graph & graph, const std::string & filename);
+
+    // Maps a snapshot written by saveGraphSnapshot. The offsets and neighbours are always checked to form a valid
+    // adjacency, a corrupt or truncated file throws std::runtime_error instead of being read out of bounds later. The
+    // checksum, which also covers the weights, is only recomputed when asked for.
+    Graph loadGraphSnapshot(const std::string & filename, bool verifyChecksum = false);
+
+    // getGraphByType, but the result is kept as a snapshot in directory and mapped from there by later calls with the
+    // same parameters. An empty directory disables the cache.
+    Graph getGraphByTypeCached(int i, int param, double param2, int seed, const std::string & directory);
+}
+
+#endif //LCSCGA_GRAPHSNAPSHOT_H
@@ -0,0 +1,20 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_PARALLEL_H
+#define LCSCGA_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace graph_lib {
+    // Number of threads to use when the caller asks for 0, i.e. "all cores".
+    unsigned int defaultThreadCount();
+
+    // Calls body(i) for every i in [0, count) from up to threads threads (0 for all cores). Indices are handed out one
+    // at a time, so uneven work balances out. If any call throws, the first exception is rethrown here once all
+    // threads have stopped.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> & body, unsigned int threads = 0);
+}
+
+#endif //LCSCGA_PARALLEL_H
@@ -0,0 +1,72 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_PERFCOUNTERS_H
+#define LCSCGA_PERFCOUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace graph_lib {
+    enum class PerfEvent {
+        Cycles,
+        Instructions,
+        L1Misses,       // L1 data cache read misses
+        LlcMisses,      // Last level cache misses
+        BranchMisses
+    };
+
+    constexpr std::size_t perfEventCount = 5;
+    constexpr std::array<const char *, perfEventCount> perfEventNames = {
+            "cycles", "instructions", "l1_misses", "llc_misses", "branch_misses"};
+
+    // Hardware counter values, -1 for events that could not be counted.
+    struct PerfSample {
+        std::array<std::int64_t, perfEventCount> values{-1, -1, -1, -1, -1};
+
+        bool has(PerfEvent event) const { return values[static_cast<std::size_t>(event)] >= 0; }
+        std::int64_t operator[](PerfEvent event) const { return values[static_cast<std::size_t>(event)]; }
+
+        // Element wise, an event missing from either side is missing from the result.
+        PerfSample operator-(const PerfSample & other) const;
+        PerfSample & operator+=(const PerfSample & other);
+
+        // Instructions per cycle, NaN if either is missing.
+        double ipc() const;
+        // event per unit of work, e.g. LLC misses per decode step, NaN if the event is missing or work is 0.
+        double per(PerfEvent event, std::uint64_t work) const;
+        // IPC and the misses per decode step, or why there are no numbers, for printing after a run. decodeSteps is 0
+        // without GAL_INSTRUMENT, the summary then says the per step misses need an instrumented build.
+        std::string summary(std::uint64_t decodeSteps) const;
+    };
+
+    /**
+     ** Counts cycles, instructions, cache and branch misses of the calling thread and the threads it starts from now
+     ** on, in user space, using Linux perf_event_open. Counting runs from construction on, measure a section by
+     ** subtracting two reads.
+     **
+     ** Never throws: without perf support (other systems, containers that block the syscall, a perf_event_paranoid
+     ** setting above 2, no PMU in a VM) the missing events read as -1 and reason() says why.
+     **/
+    class PerfCounters {
+    public:
+        PerfCounters();
+        ~PerfCounters();
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters & operator=(const PerfCounters &) = delete;
+
+        // True if at least one event is counted.
+        bool available() const;
+        // Why events are missing, empty if all of them are counted.
+        const std::string & reason() const;
+        // Totals since construction, scaled up for the time an event was multiplexed out.
+        PerfSample read() const;
+
+    private:
+        std::array<int, perfEventCount> fds;
+        std::string failure;
+    };
+}
+
+#endif //LCSCGA_PERFCOUNTERS_H
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <string>
 #include "chromosome.hpp"
 
 namespace gal {
@@ -35,6 +36,17 @@ namespace gal {
          */
         virtual double evaluate(C chromosome) const = 0;
 
+        /**
+         * The state of any random number generator the problem or its chromosomes draw from, for checkpoints.
+         * Problems without one keep the default, an empty state.
+         */
+        virtual std::string randomState() const { return {}; }
+
+        /**
+         * Continues from a state returned by randomState().
+         */
+        virtual void setRandomState(const std::string & /*state*/) {}
+
         unsigned int getChromosomeLength() {return chromosome_length_;}
         bool local_search_;
     protected:
@@ -2,14 +2,25 @@
 // Created by emi on 09/12/2021.
 //
 #include "graph.h"
+#include "disjointSet.h"
 
 #ifndef LCSCGA_RANDOMGRAPH_H
 #define LCSCGA_RANDOMGRAPH_H
 namespace graph_lib {
     Graph erdosGraphRecursive(unsigned int nodes, double p, int seed);
     Graph erdosGraphRejection(unsigned int nodes, double p, int seed);
-    std::vector<std::vector<unsigned int>> erdosInputGen(unsigned int nodes, double p, int seed);\
-    std::vector<std::vector<unsigned int>> findConnectedComponents(std::vector<std::vector<unsigned int>> input, unsigned int nodes) ;
+    // A G(nodes, p) graph from erdosInputGenSkip, made connected by bridging its components along a random tree, in
+    // near linear time. Always has exactly the requested number of nodes. A weightLimit caps the edge weights, e.g. at
+    // 65535 for graphs that are converted to a CompactGraph.
+    Graph erdosGraphConnected(unsigned int nodes, double p, int seed, unsigned int threads = 0,
+                              std::uint32_t weightLimit = 0);
+    EdgeList erdosInputGen(unsigned int nodes, double p, int seed);
+    // Same distribution as erdosInputGen, but in O(nodes + edges) by skipping over the pairs that get no edge. The
+    // pairs are split into chunks that are generated in parallel, the output only depends on the seed.
+    // (0 threads = all cores)
+    EdgeList erdosInputGenSkip(unsigned int nodes, double p, int seed, unsigned int threads = 0,
+                               std::uint32_t weightLimit = 0);
+    Components findConnectedComponents(const EdgeList & input, unsigned int nodes);
 
     }
 #endif //LCSCGA_RANDOMGRAPH_H
@@ -0,0 +1,37 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_REDUCTION_H
+#define LCSCGA_REDUCTION_H
+
+#include "graph.h"
+#include "disjointSet.h"
+#include "exactSolver.h"
+
+namespace graph_lib {
+    /**
+     ** A smaller graph with the same longest path length, and what is needed to map its paths back.
+     ** - Pendant trees are cut off. Every remaining node they hung from gets at most two new leaves instead, whose
+     **   edges weigh as much as the two deepest branches, so a path can still end in a branch or run from one into
+     **   the other.
+     ** - Chains of degree 2 nodes keep only their two ends and the two ends of their lightest edge, joined by edges
+     **   as heavy as the runs in between. A path that ends inside a chain can always go on to one of those nodes.
+     ** Paths that lie entirely inside a cut off tree are not in graph, the best of them is kept in internal.
+     **/
+    struct Reduction {
+        Graph graph;
+        std::vector<unsigned int> original;     // The original id of every node of graph (0 for node 0)
+        std::vector<unsigned int> partner;      // The other end of the chain edge at every node of graph, or 0
+        Components hidden;                      // Chain edge interiors (at the smaller end) and branches below leaves
+        std::vector<bool> leaf;                 // Whether a node of graph is a new leaf standing for a branch
+        PathSolution internal;
+
+        // The path in the original graph that reduced (a path in graph) stands for, or internal if that is longer.
+        PathSolution expand(const PathSolution & reduced) const;
+    };
+
+    // O(nodes + edges). Edge weights must be non-negative. Components that are a single cycle are left as they are.
+    Reduction reduceGraph(const Graph & graph);
+}
+
+#endif //LCSCGA_REDUCTION_H
@@ -0,0 +1,42 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_RELABEL_H
+#define LCSCGA_RELABEL_H
+
+#include <string>
+#include "graph.h"
+#include "exactSolver.h"
+
+namespace graph_lib {
+    enum class NodeOrder {
+        Original,
+        Bfs,                    // Breadth first from a low degree node of every component
+        ReverseCuthillMcKee,    // Breadth first visiting low degree neighbours first, then reversed
+        Degree                  // Highest degree first, so the hubs most paths run through share cache lines
+    };
+
+    // Parses "none", "bfs", "rcm" or "degree", as used in the ini files.
+    NodeOrder parseNodeOrder(const std::string & name);
+
+    /**
+     ** The same graph with its nodes renumbered, so that nodes close to each other in the graph get close ids and their
+     ** adjacency rows and genes end up close in memory. Paths and chromosomes of graph map back to the original ids
+     ** with restore and restoreGenes.
+     **/
+    struct Relabeling {
+        Graph graph;
+        std::vector<unsigned int> toOriginal;   // toOriginal[new id] = original id, both 0 for node 0
+        std::vector<unsigned int> toNew;        // toNew[original id] = new id
+
+        PathSolution restore(const PathSolution & path) const;
+        // Genes are a start node in genes[0] followed by a node per node, as in PathChromosome.
+        std::vector<unsigned int> restoreGenes(const std::vector<unsigned int> & genes) const;
+        std::vector<unsigned int> relabelGenes(const std::vector<unsigned int> & genes) const;
+    };
+
+    // O(nodes + edges), apart from sorting neighbours by degree for ReverseCuthillMcKee and nodes for Degree.
+    Relabeling relabelGraph(const Graph & graph, NodeOrder order);
+}
+
+#endif //LCSCGA_RELABEL_H
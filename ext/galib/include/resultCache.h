@@ -0,0 +1,67 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_RESULTCACHE_H
+#define LCSCGA_RESULTCACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace graph_lib {
+    // Bump this whenever the entry layout below changes, older entries are then ignored and pruned.
+    constexpr std::uint32_t resultCacheVersion = 1;
+
+    /**
+     ** Builds a cache key out of everything a result depends on, with 64 bit FNV-1a.
+     **/
+    class KeyHasher {
+    public:
+        KeyHasher & add(const void * data, std::size_t length);
+        KeyHasher & add(std::string_view text);
+
+        template <typename T> requires std::is_arithmetic_v<T>
+        KeyHasher & add(T value) {
+            return add(&value, sizeof(value));
+        }
+
+        std::uint64_t value() const { return hash_; }
+
+    private:
+        std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+    };
+
+    /**
+     ** Content addressed store of experiment results on disk. Each result is a vector of doubles in its own small file,
+     ** named after its key and spread over 256 subdirectories. An entry is only returned to callers with the same
+     ** algorithm version as the one that stored it, so bumping the version invalidates everything computed before,
+     ** and prune() deletes those entries. An empty directory disables the cache: nothing is loaded or stored.
+     **
+     ** Entries are written under a temporary name and renamed, so threads and processes can share a store.
+     **/
+    class ResultCache {
+    public:
+        ResultCache(std::string directory, std::uint32_t algorithmVersion);
+
+        bool enabled() const { return !directory_.empty(); }
+
+        // The values stored under key, nothing if there are none or the entry is of another version or its size does
+        // not match its header.
+        std::optional<std::vector<double>> load(std::uint64_t key) const;
+        void store(std::uint64_t key, const std::vector<double> & values) const;
+
+        // Deletes the entries of other versions, and unreadable ones. Returns the number of entries deleted.
+        std::size_t prune() const;
+
+    private:
+        std::string directory_;
+        std::uint32_t algorithmVersion_;
+
+        std::string path(std::uint64_t key) const;
+    };
+}
+
+#endif //LCSCGA_RESULTCACHE_H
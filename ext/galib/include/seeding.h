@@ -0,0 +1,35 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_SEEDING_H
+#define LCSCGA_SEEDING_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "graph.h"
+
+namespace graph_lib {
+    enum class SeedHeuristic {
+        GreedyWalk,     // Walk both ways from a random node, each step picking one of the heaviest unvisited edges
+        RandomDfs,      // Depth first search with shuffled neighbours from low degree nodes, keeping the deepest path
+        Warnsdorff      // Walk from a low degree node, always to the neighbour with the fewest unvisited neighbours
+    };
+
+    // A path found by heuristic, as its nodes in order. Empty for graphs without nodes.
+    template <typename G>
+    std::vector<unsigned int> seedPath(const G & graph, SeedHeuristic heuristic, std::mt19937 & gen);
+
+    // Preferences (genes[0] the start node, genes[v] the preferred neighbour of v, as in PathChromosome) that decode to
+    // path, or to a longer path through it. The genes of nodes off the path point to random neighbours.
+    template <typename G>
+    std::vector<unsigned int> encodePath(const G & graph, const std::vector<unsigned int> & path, std::mt19937 & gen);
+
+    // count encoded seed paths, cycling through the heuristics. Built in parallel (0 threads = all cores), the result
+    // only depends on seed.
+    template <typename G>
+    std::vector<std::vector<unsigned int>> seedChromosomes(const G & graph, std::size_t count, std::uint64_t seed,
+                                                           unsigned int threads = 0);
+}
+
+#endif //LCSCGA_SEEDING_H
@@ -0,0 +1,49 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_STRUCTUREDSOLVER_H
+#define LCSCGA_STRUCTUREDSOLVER_H
+
+#include <optional>
+#include "exactSolver.h"
+
+namespace graph_lib {
+    enum class GraphStructure {
+        Forest,         // No cycles (includes graphs without edges)
+        Cycle,          // A single connected ring
+        BlockTree,      // Every biconnected block is a cycle or has at most blockDpMaxNodes nodes, within blockDpBudget
+        General
+    };
+
+    // Blocks that are not a cycle and have at most this many nodes get a table of the longest paths between all their
+    // node pairs, filled by a subset DP per start node, O(k^3 2^k) for k nodes.
+    constexpr unsigned int blockTableMaxNodes = 12;
+
+    // Larger blocks, up to this many nodes, only get the rows of their articulation points, a subset DP per
+    // articulation point, and longestPathDp once for the best path inside them.
+    constexpr unsigned int blockDpMaxNodes = 16;
+
+    // Bound on the work of all larger blocks together, sum over them of (articulation points + 1) k^2 2^k. Graphs
+    // beyond it are GraphStructure::General, so the structured solve stays a small fraction of a GA run.
+    constexpr std::uint64_t blockDpBudget = std::uint64_t(1) << 28;
+
+    GraphStructure detectStructure(const Graph & graph);
+
+    // Weighted diameter of every tree, by two passes over it: the node furthest from any node is an end of a longest
+    // path. O(nodes + edges).
+    PathSolution longestPathForest(const Graph & graph);
+
+    // Everything but the lightest edge. O(nodes).
+    PathSolution longestPathCycle(const Graph & graph);
+
+    // Solves every block on its own (in parallel, on up to threads threads) for the longest paths between its nodes,
+    // then runs a DP over the block-cut tree: every articulation point keeps the best path hanging below it, and
+    // every block and articulation point combines the two best of those running through it. Linear apart from the
+    // subset DPs of the blocks that are not cycles, which blockTableMaxNodes, blockDpMaxNodes and blockDpBudget bound.
+    PathSolution longestPathBlockTree(const Graph & graph, unsigned int threads = 0);
+
+    // Dispatches to the solver for the structure of graph, or returns nothing for GraphStructure::General.
+    std::optional<PathSolution> longestPathStructured(const Graph & graph, unsigned int threads = 0);
+}
+
+#endif //LCSCGA_STRUCTUREDSOLVER_H
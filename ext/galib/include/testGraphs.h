@@ -9,23 +9,27 @@
 #include "graph.h"
 
 namespace graph_lib {
-    std::vector <std::vector<unsigned int>> simpleConnComp(unsigned int param);
+    EdgeList simpleConnComp(unsigned int param);
 
-    std::vector <std::vector<unsigned int>> exampleGraph(unsigned int param);
+    EdgeList exampleGraph(unsigned int param);
 
-    std::vector <std::vector<unsigned int>> ringGraphTricky(unsigned int param);
+    EdgeList ringGraphTricky(unsigned int param);
 
-    std::vector <std::vector<unsigned int>> ringGraphAscending(unsigned int param);
+    EdgeList ringGraphAscending(unsigned int param);
 
-    std::vector <std::vector<unsigned int>> kiteGraph(unsigned int param);
+    EdgeList kiteGraph(unsigned int param);
 
-    std::vector <std::vector<unsigned int>> antiLoop(unsigned int nodes);
+    EdgeList antiLoop(unsigned int nodes);
 
     /**
      ** Select graph from file initialisation
-     ** 1: randomRecursive, 2: randomRejection
+     ** 0: randomRecursive, 1: randomRejection, 2: exampleGraph
      ** 3: ringGraph 2s and 1x1, 4: ringGraph ascending.
      ** 5: Kitegraph, 6: Antiloop (a-b-c-d with ab, cd = inf, and b-c two paths)
+     ** 7: sparse random graph (not necessarily connected), generated in O(n + m)
+     ** 8: connected sparse random graph, generated in near O(n + m)
+     ** 9-13: planted path, grid, ladder, random geometric and Barabasi-Albert graphs with known optima, param2 being
+     **       the mean degree of their noise edges (see benchmarkGraphs.h)
      **/
     Graph getGraphByType(int i, int param, double param2, int seed);
 }
@@ -0,0 +1,65 @@
+//
+// Created on 18/10/2026.
+//
+#ifndef LCSCGA_THREADPOOL_H
+#define LCSCGA_THREADPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graph_lib {
+    /**
+     ** Thread pool where every worker has its own task deque. A worker runs the newest task of its own deque first,
+     ** and when that is empty steals the oldest task of another worker. Tasks submitted from inside a task go to the
+     ** submitting worker's deque, so recursive searches keep working depth first on their own subtree while idle
+     ** workers take the large, old subtrees.
+     **/
+    class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(unsigned int threads = 0);
+        ~WorkStealingPool();
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+
+        void submit(std::function<void()> task);
+        // Blocks until every submitted task (including tasks submitted by tasks) has finished. Rethrows the first
+        // exception a task threw, if any.
+        void wait();
+        // wait(), but gives up after timeout. Returns whether all tasks finished.
+        bool waitFor(std::chrono::milliseconds timeout);
+
+        unsigned int getThreadCount() const;
+        // Workers currently looking for work, useful to decide whether splitting off a task is worth it.
+        unsigned int getIdleCount() const;
+    private:
+        struct Worker {
+            std::deque<std::function<void()>> tasks;
+            std::mutex mutex;
+        };
+
+        void run(unsigned int index);
+        bool tryTake(unsigned int index, std::function<void()> & task);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        std::condition_variable allDone;
+        std::atomic<std::size_t> pending{0};   // Submitted but not finished tasks
+        std::atomic<std::size_t> queued{0};    // Tasks sitting in a deque or about to be pushed onto one
+        std::atomic<unsigned int> idle{0};
+        std::atomic<unsigned int> nextWorker{0};
+        bool stopping = false;
+        std::exception_ptr failure;
+    };
+}
+
+#endif //LCSCGA_THREADPOOL_H
@@ -16,7 +16,9 @@
 #include <random>
 
 std::random_device rd; // NOLINT(cert-err58-cpp)
-std::default_random_engine engine(rd()); // NOLINT(cert-err58-cpp)
+// Every thread draws from its own engine, so GA runs on different threads neither race nor disturb each other's
+// streams. Seed it on the thread that runs the GA for reproducible runs.
+thread_local std::default_random_engine engine(rd()); // NOLINT(cert-err58-cpp)
 
 /**
  * Produces a natural number randomly between 0 and nmax-1.
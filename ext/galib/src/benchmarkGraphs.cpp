@@ -0,0 +1,173 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include "../include/benchmarkGraphs.h"
+
+namespace graph_lib {
+    namespace {
+        std::uint32_t noiseWeight(std::mt19937_64 & gen) {
+            return std::uniform_int_distribution<std::uint32_t>(1, plantedWeight - 1)(gen);
+        }
+
+        void plantPath(const std::vector<unsigned int> & order, const EdgeSink & sink) {
+            for (std::size_t i = 0; i + 1 < order.size(); i++) sink({order[i], order[i + 1], plantedWeight});
+        }
+
+        std::vector<unsigned int> randomOrder(unsigned int nodes, std::mt19937_64 & gen) {
+            std::vector<unsigned int> order(nodes);
+            std::iota(order.begin(), order.end(), 1);
+            std::shuffle(order.begin(), order.end(), gen);
+            return order;
+        }
+    }
+
+    void plantedPathEdges(unsigned int nodes, double degree, int seed, const EdgeSink & sink) {
+        std::mt19937_64 gen(seed);
+        plantPath(randomOrder(nodes, gen), sink);
+        if (nodes < 2) return;
+        std::uniform_int_distribution<unsigned int> node(1, nodes);
+        const auto noise = static_cast<std::uint64_t>(std::llround(nodes * std::max(degree, 0.0) / 2));
+        for (std::uint64_t i = 0; i < noise; i++) {
+            auto u = node(gen), v = node(gen);
+            if (u != v) sink({u, v, noiseWeight(gen)});
+        }
+    }
+
+    void gridEdges(unsigned int nodes, unsigned int width, const EdgeSink & sink) {
+        if (width == 0) throw std::invalid_argument("Grid width has to be at least 1.");
+        // Row 0 holds the remainder (or is a full row), every other row is full.
+        const unsigned int first = nodes % width == 0 ? std::min(width, nodes) : nodes % width;
+        auto id = [&](unsigned int row, unsigned int column) {
+            return row == 0 ? column + 1 : first + (row - 1) * width + column + 1;
+        };
+        const unsigned int rows = nodes == 0 ? 0 : 1 + (nodes - first) / width;
+        for (unsigned int row = 0; row < rows; row++) {
+            const unsigned int columns = row == 0 ? first : width;
+            for (unsigned int column = 0; column < columns; column++) {
+                if (column + 1 < columns) sink({id(row, column), id(row, column + 1), 1});
+                if (row + 1 < rows) sink({id(row, column), id(row + 1, column), 1});
+            }
+        }
+    }
+
+    void randomGeometricEdges(unsigned int nodes, double degree, int seed, const EdgeSink & sink) {
+        std::mt19937_64 gen(seed);
+        std::uniform_real_distribution<double> coordinate(0, 1);
+        std::vector<double> x(nodes + 1), y(nodes + 1);
+        for (unsigned int v = 1; v <= nodes; v++) {
+            x[v] = coordinate(gen);
+            y[v] = coordinate(gen);
+        }
+        // A disk of radius r holds nodes * pi * r^2 points on average, ignoring the border.
+        const double radius = nodes > 0 ? std::min(1.0, std::sqrt(std::max(degree, 0.0) / (M_PI * nodes))) : 1;
+        const auto cells = static_cast<unsigned int>(std::clamp(std::floor(1 / std::max(radius, 1e-9)), 1.0,
+                                                                std::max(1.0, std::sqrt(static_cast<double>(nodes)))));
+        auto cellOf = [&](double c) { return std::min(static_cast<unsigned int>(c * cells), cells - 1); };
+
+        // The planted path runs through the rows of cells alternately left to right and right to left.
+        std::vector<unsigned int> order(nodes);
+        std::iota(order.begin(), order.end(), 1);
+        std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+            auto rowA = cellOf(y[a]), rowB = cellOf(y[b]);
+            if (rowA != rowB) return rowA < rowB;
+            return rowA % 2 == 0 ? x[a] < x[b] : x[a] > x[b];
+        });
+        plantPath(order, sink);
+
+        // Bucket the points by cell (counting sort), then only compare points in neighbouring cells.
+        std::vector<unsigned int> start(cells * cells + 1, 0), bucket(nodes);
+        auto cellIndex = [&](unsigned int v) { return cellOf(y[v]) * cells + cellOf(x[v]); };
+        for (unsigned int v = 1; v <= nodes; v++) start[cellIndex(v) + 1]++;
+        std::partial_sum(start.begin(), start.end(), start.begin());
+        std::vector<unsigned int> cursor(start.begin(), start.end() - 1);
+        for (unsigned int v = 1; v <= nodes; v++) bucket[cursor[cellIndex(v)]++] = v;
+        const double squared = radius * radius;
+        // Going through the points cell by cell keeps the neighbouring cells in cache.
+        for (auto v : bucket) {
+            const int row = static_cast<int>(cellOf(y[v])), column = static_cast<int>(cellOf(x[v]));
+            for (int r = std::max(row - 1, 0); r <= std::min(row + 1, static_cast<int>(cells) - 1); r++) {
+                for (int c = std::max(column - 1, 0); c <= std::min(column + 1, static_cast<int>(cells) - 1); c++) {
+                    const auto cell = r * cells + c;
+                    for (auto k = start[cell]; k < start[cell + 1]; k++) {
+                        auto u = bucket[k];
+                        const double dx = x[u] - x[v], dy = y[u] - y[v];
+                        if (u > v && dx * dx + dy * dy <= squared) sink({v, u, noiseWeight(gen)});
+                    }
+                }
+            }
+        }
+    }
+
+    void barabasiAlbertEdges(unsigned int nodes, double degree, int seed, const EdgeSink & sink) {
+        std::mt19937_64 gen(seed);
+        plantPath(randomOrder(nodes, gen), sink);
+        const auto attach = static_cast<unsigned int>(std::max(1L, std::lround(degree / 2)));
+        // Every edge puts both its endpoints in here, so a uniform pick is a pick proportional to degree.
+        std::vector<unsigned int> endpoints;
+        endpoints.reserve(2 * static_cast<std::size_t>(nodes) * attach);
+        const unsigned int core = std::min(nodes, attach + 1);
+        for (unsigned int u = 1; u <= core; u++) {
+            for (unsigned int v = u + 1; v <= core; v++) {
+                sink({u, v, noiseWeight(gen)});
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+        std::vector<unsigned int> targets;
+        for (unsigned int v = core + 1; v <= nodes; v++) {
+            targets.clear();
+            while (targets.size() < attach) {
+                auto u = endpoints[std::uniform_int_distribution<std::size_t>(0, endpoints.size() - 1)(gen)];
+                if (std::find(targets.begin(), targets.end(), u) == targets.end()) targets.push_back(u);
+            }
+            for (auto u : targets) {
+                sink({u, v, noiseWeight(gen)});
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+    }
+
+    bool isBenchmarkGraphType(int type) {
+        return type >= 9 && type <= 13;
+    }
+
+    void benchmarkGraphEdges(int type, unsigned int nodes, double param2, int seed, const EdgeSink & sink) {
+        switch (type) {
+            case 9: return plantedPathEdges(nodes, param2, seed, sink);
+            case 10: {
+                auto width = static_cast<unsigned int>(std::sqrt(static_cast<double>(nodes)));
+                return gridEdges(nodes, std::max(width, 1u), sink);
+            }
+            case 11: return gridEdges(nodes, 2, sink);
+            case 12: return randomGeometricEdges(nodes, param2, seed, sink);
+            case 13: return barabasiAlbertEdges(nodes, param2, seed, sink);
+        }
+        throw std::invalid_argument("Unknown benchmark graph type " + std::to_string(type) + ".");
+    }
+
+    EdgeList benchmarkGraphEdges(int type, unsigned int nodes, double param2, int seed) {
+        EdgeList edges;
+        benchmarkGraphEdges(type, nodes, param2, seed, [&](const Edge & edge) { edges.push_back(edge); });
+        return edges;
+    }
+
+    std::optional<std::uint64_t> knownOptimum(int type, unsigned int nodes) {
+        if (!isBenchmarkGraphType(type)) return std::nullopt;
+        const std::uint64_t edges = nodes > 0 ? nodes - 1 : 0;
+        return type == 10 || type == 11 ? edges : edges * plantedWeight;
+    }
+
+    void writeEdgeListHeader(std::ostream & out, unsigned int nodes) {
+        out << nodes << '\n';
+    }
+
+    EdgeSink edgeListWriter(std::ostream & out) {
+        return [&out](const Edge & edge) { out << edge.u << ' ' << edge.v << ' ' << edge.w << '\n'; };
+    }
+}
@@ -0,0 +1,111 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <numeric>
+#include "../include/blocks.h"
+
+namespace graph_lib {
+    namespace {
+        struct Frame {
+            unsigned int node;
+            unsigned int parent;
+            unsigned int next;  // Index of the next neighbour to look at
+        };
+    }
+
+    Blocks biconnectedComponents(const Graph & graph) {
+        const unsigned int n = graph.getNodeCount();
+        std::vector<unsigned int> discovered(n + 1, 0), low(n + 1, 0), stamp(n + 1, 0);
+        EdgeList edgeStack;
+        std::vector<Frame> frames;
+        Blocks output;
+        output.blockCount.assign(n + 1, 0);
+        output.blocks.offsets.push_back(0);
+        output.edgeOffsets.push_back(0);
+        unsigned int time = 0;
+
+        auto closeBlock = [&]() {
+            auto begin = output.blocks.offsets.back();
+            std::sort(output.blocks.nodes.begin() + begin, output.blocks.nodes.end());
+            for (auto k = begin; k < output.blocks.nodes.size(); k++) output.blockCount[output.blocks.nodes[k]]++;
+            output.blocks.offsets.push_back(output.blocks.nodes.size());
+            output.edgeOffsets.push_back(output.edges.size());
+        };
+        auto addNode = [&](unsigned int v) {
+            // stamp remembers which block a node was last added to, so every node is added once per block.
+            if (stamp[v] != output.blocks.size() + 1) {
+                stamp[v] = output.blocks.size() + 1;
+                output.blocks.nodes.push_back(v);
+            }
+        };
+
+        for (unsigned int root = 1; root <= n; root++) {
+            if (discovered[root]) continue;
+            discovered[root] = low[root] = ++time;
+            if (graph.getDegree(root) == 0) {
+                addNode(root);
+                closeBlock();
+                continue;
+            }
+            frames.push_back({root, 0, 0});
+            while (!frames.empty()) {
+                auto & frame = frames.back();
+                const auto v = frame.node;
+                auto neighbours = graph.getNeighbours(v);
+                if (frame.next < neighbours.size()) {
+                    const auto w = static_cast<std::uint32_t>(graph.getWeights(v)[frame.next]);
+                    const auto u = neighbours[frame.next++];
+                    if (!discovered[u]) {
+                        edgeStack.push_back({v, u, w});
+                        discovered[u] = low[u] = ++time;
+                        frames.push_back({u, v, 0});    // invalidates frame
+                    } else if (u != frame.parent && discovered[u] < discovered[v]) {
+                        edgeStack.push_back({v, u, w});
+                        low[v] = std::min(low[v], discovered[u]);
+                    }
+                    continue;
+                }
+                // v is done, report back to its parent.
+                const auto parent = frame.parent;
+                frames.pop_back();
+                if (frames.empty()) break;
+                low[parent] = std::min(low[parent], low[v]);
+                if (low[v] >= discovered[parent]) {
+                    // Nothing below v reaches above parent, so the edges since (parent, v) form a block.
+                    while (true) {
+                        auto edge = edgeStack.back();
+                        edgeStack.pop_back();
+                        addNode(edge.u);
+                        addNode(edge.v);
+                        output.edges.push_back(edge);
+                        if (edge.u == parent && edge.v == v) break;
+                    }
+                    closeBlock();
+                }
+            }
+        }
+        return output;
+    }
+
+    BlockCutTree blockCutTree(const Blocks & blocks) {
+        const auto n = static_cast<unsigned int>(blocks.blockCount.size() - 1);
+        BlockCutTree tree;
+        // Counting sort the (node, block) memberships by node, the blocks of a node then come out ascending.
+        tree.blocksAt.offsets.assign(n + 2, 0);
+        for (auto v : blocks.blocks.nodes) tree.blocksAt.offsets[v + 1]++;
+        std::partial_sum(tree.blocksAt.offsets.begin(), tree.blocksAt.offsets.end(), tree.blocksAt.offsets.begin());
+        tree.blocksAt.nodes.resize(blocks.blocks.nodes.size());
+        std::vector<unsigned int> cursor(tree.blocksAt.offsets.begin(), tree.blocksAt.offsets.end() - 1);
+
+        tree.cuts.offsets.push_back(0);
+        for (std::size_t b = 0; b < blocks.blocks.size(); b++) {
+            for (auto v : blocks.blocks[b]) {
+                tree.blocksAt.nodes[cursor[v]++] = b;
+                if (blocks.isArticulation(v)) tree.cuts.nodes.push_back(v);
+            }
+            tree.cuts.offsets.push_back(tree.cuts.nodes.size());
+        }
+        return tree;
+    }
+}
@@ -0,0 +1,238 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+#include "../include/branchAndBound.h"
+#include "../include/threadPool.h"
+
+namespace graph_lib {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Nodes explored by a thread before it adds them to the shared counter.
+        constexpr std::uint64_t exploredBatch = 1024;
+
+        class Search {
+        public:
+            Search(const Graph & graph, WorkStealingPool & pool)
+                : graph(graph), pool(pool), n(graph.getNodeCount()), words(n / 64 + 1),
+                  adjacency((n + 1) * words, 0), heaviest(n + 1, 0), rootBound(n + 1, 0),
+                  openTasks(new std::atomic<std::size_t>[n + 1]), incomplete(new std::atomic<bool>[n + 1]) {
+                for (unsigned int v = 1; v <= n; v++) {
+                    auto weights = graph.getWeights(v);
+                    for (auto w : weights) {
+                        if (w < 0) throw std::invalid_argument("Edge weights need to be non-negative.");
+                        heaviest[v] = std::max<std::uint64_t>(heaviest[v], w);
+                    }
+                    for (auto u : graph.getNeighbours(v)) row(adjacency, v)[u / 64] |= std::uint64_t(1) << (u % 64);
+                    openTasks[v] = 0;
+                    incomplete[v] = false;
+                }
+                std::vector<std::uint64_t> visited(words, 0), reach(words), frontier(words), next(words);
+                for (unsigned int v = 1; v <= n; v++) {
+                    visited[v / 64] |= std::uint64_t(1) << (v % 64);
+                    rootBound[v] = reachableWeight(v, visited, reach, frontier, next);
+                    visited[v / 64] = 0;
+                }
+            }
+
+            void offer(const PathSolution & solution) {
+                std::lock_guard<std::mutex> lock(bestMutex);
+                if (solution.length > incumbent || best.nodes.empty()) {
+                    best = solution;
+                    incumbent = solution.length;
+                }
+            }
+
+            void start(unsigned int v) {
+                openTasks[v]++;
+                pool.submit([this, v] { explore(v, {v}, 0); });
+            }
+
+            BranchAndBoundProgress progress(Clock::time_point began) {
+                std::uint64_t bound = incumbent;
+                for (unsigned int v = 1; v <= n; v++) {
+                    if (openTasks[v] > 0 || incomplete[v]) bound = std::max(bound, rootBound[v]);
+                }
+                return {incumbent, bound, explored, std::chrono::duration<double>(Clock::now() - began).count()};
+            }
+
+            PathSolution getBest() {
+                std::lock_guard<std::mutex> lock(bestMutex);
+                return best;
+            }
+
+            std::atomic<bool> stop{false};
+
+        private:
+            // Per task scratch space, so the search itself does not allocate.
+            struct Scratch {
+                std::vector<std::uint64_t> visited, reach, frontier, next;
+                std::vector<std::vector<std::pair<std::int32_t, unsigned int>>> children; // per depth
+                std::uint64_t explored = 0;
+            };
+
+            static std::uint64_t * row(std::vector<std::uint64_t> & bits, unsigned int v, unsigned int words) {
+                return bits.data() + static_cast<std::size_t>(v) * words;
+            }
+            std::uint64_t * row(std::vector<std::uint64_t> & bits, unsigned int v) { return row(bits, v, words); }
+            const std::uint64_t * row(unsigned int v) const {
+                return adjacency.data() + static_cast<std::size_t>(v) * words;
+            }
+
+            // Sum of the heaviest edge of every unvisited node reachable from v without crossing visited nodes. Every
+            // node a path from v can still add brings one new edge, which weighs at most that much.
+            std::uint64_t reachableWeight(unsigned int v, const std::vector<std::uint64_t> & visited,
+                                          std::vector<std::uint64_t> & reach, std::vector<std::uint64_t> & frontier,
+                                          std::vector<std::uint64_t> & next) const {
+                bool growing = false;
+                for (unsigned int k = 0; k < words; k++) {
+                    frontier[k] = row(v)[k] & ~visited[k];
+                    reach[k] = frontier[k];
+                    growing |= frontier[k] != 0;
+                }
+                std::uint64_t total = 0;
+                while (growing) {
+                    // Expand the whole frontier at once: the new frontier is every neighbour not seen yet.
+                    std::fill(next.begin(), next.end(), 0);
+                    for (unsigned int k = 0; k < words; k++) {
+                        for (auto bits = frontier[k]; bits; bits &= bits - 1) {
+                            auto u = k * 64 + std::countr_zero(bits);
+                            total += heaviest[u];
+                            for (unsigned int j = 0; j < words; j++) next[j] |= row(u)[j];
+                        }
+                    }
+                    growing = false;
+                    for (unsigned int k = 0; k < words; k++) {
+                        frontier[k] = next[k] & ~visited[k] & ~reach[k];
+                        reach[k] |= frontier[k];
+                        growing |= frontier[k] != 0;
+                    }
+                }
+                return total;
+            }
+
+            void explore(unsigned int origin, std::vector<unsigned int> path, std::uint64_t length) {
+                Scratch scratch;
+                scratch.visited.assign(words, 0);
+                scratch.reach.resize(words);
+                scratch.frontier.resize(words);
+                scratch.next.resize(words);
+                scratch.children.resize(n + 1);
+                for (auto v : path) scratch.visited[v / 64] |= std::uint64_t(1) << (v % 64);
+                dfs(origin, path, length, scratch);
+                explored += scratch.explored;
+                openTasks[origin]--;
+            }
+
+            void dfs(unsigned int origin, std::vector<unsigned int> & path, std::uint64_t length, Scratch & scratch) {
+                if (stop) {
+                    incomplete[origin] = true;
+                    return;
+                }
+                if (++scratch.explored == exploredBatch) {
+                    explored += scratch.explored;
+                    scratch.explored = 0;
+                }
+                if (length > incumbent) offer({length, path});
+
+                const auto v = path.back();
+                auto bound = length
+                             + reachableWeight(v, scratch.visited, scratch.reach, scratch.frontier, scratch.next);
+                if (bound <= incumbent) return;
+
+                // Try the heavy edges first, good incumbents early make the bound cut more.
+                auto & children = scratch.children[path.size()];
+                children.clear();
+                auto neighbours = graph.getNeighbours(v);
+                auto weights = graph.getWeights(v);
+                for (std::size_t k = 0; k < neighbours.size(); k++) {
+                    auto u = neighbours[k];
+                    if (!(scratch.visited[u / 64] >> (u % 64) & 1)) children.emplace_back(weights[k], u);
+                }
+                std::sort(children.begin(), children.end(), std::greater<>());
+
+                for (auto [w, u] : children) {
+                    if (pool.getIdleCount() > 0 && path.size() * 2 < n) {
+                        // Somebody is out of work, hand them this subtree instead of searching it ourselves.
+                        auto split = path;
+                        split.push_back(u);
+                        openTasks[origin]++;
+                        pool.submit([this, origin, split = std::move(split), length, w = w]() mutable {
+                            explore(origin, std::move(split), length + w);
+                        });
+                        continue;
+                    }
+                    scratch.visited[u / 64] |= std::uint64_t(1) << (u % 64);
+                    path.push_back(u);
+                    dfs(origin, path, length + w, scratch);
+                    path.pop_back();
+                    scratch.visited[u / 64] &= ~(std::uint64_t(1) << (u % 64));
+                }
+            }
+
+            const Graph & graph;
+            WorkStealingPool & pool;
+            const unsigned int n;
+            const unsigned int words;
+            std::vector<std::uint64_t> adjacency;   // Neighbour bitset of every node, words per row
+            std::vector<std::uint64_t> heaviest;    // Heaviest edge weight at every node
+            std::vector<std::uint64_t> rootBound;   // reachableWeight from every node with nothing visited
+            std::unique_ptr<std::atomic<std::size_t>[]> openTasks;  // Unfinished tasks per start node
+            std::unique_ptr<std::atomic<bool>[]> incomplete;        // Start nodes whose search was cut short
+            std::atomic<std::uint64_t> incumbent{0};
+            std::atomic<std::uint64_t> explored{0};
+            std::mutex bestMutex;
+            PathSolution best;
+        };
+    }
+
+    BranchAndBoundResult longestPathBranchAndBound(const Graph & graph, const PathSolution & initial,
+                                                   const BranchAndBoundOptions & options) {
+        const auto began = Clock::now();
+        const unsigned int n = graph.getNodeCount();
+        if (n == 0) return {{}, {0, 0, 0, 0.0}, true};
+
+        // Only trust the initial path after checking it, a wrong incumbent would cut away the optimum.
+        PathSolution seed{0, {1}};
+        if (!initial.nodes.empty()) {
+            std::uint64_t length = 0;
+            std::vector<bool> seen(n + 1, false);
+            for (std::size_t i = 0; i < initial.nodes.size(); i++) {
+                auto v = initial.nodes[i];
+                if (v == 0 || v > n || seen[v]) throw std::invalid_argument("Initial path is not a simple path.");
+                seen[v] = true;
+                if (i > 0) {
+                    auto w = graph.getEdge(initial.nodes[i - 1], v);
+                    if (w < 0) throw std::invalid_argument("Initial path uses an edge that is not in the graph.");
+                    length += w;
+                }
+            }
+            seed = {length, initial.nodes};
+        }
+
+        WorkStealingPool pool(options.threads);
+        Search search(graph, pool);
+        search.offer(seed);
+        for (unsigned int v = 1; v <= n; v++) search.start(v);
+
+        const auto interval = options.reportInterval.count() > 0 ? options.reportInterval
+                                                                  : std::chrono::milliseconds(1000);
+        while (!pool.waitFor(interval)) {
+            if (options.report) options.report(search.progress(began));
+            if (options.timeLimit.count() > 0 && Clock::now() - began >= options.timeLimit) {
+                search.stop = true;
+                pool.wait();
+                break;
+            }
+        }
+
+        auto progress = search.progress(began);
+        if (options.report) options.report(progress);
+        return {search.getBest(), progress, progress.bound == progress.incumbent};
+    }
+}
@@ -0,0 +1,25 @@
+//
+// Created on 18/10/2026.
+//
+#include "../include/counters.h"
+
+#ifdef GAL_INSTRUMENT
+#include <cstdlib>
+#include <new>
+
+// Counts allocations by replacing the global operator new. The other forms (nothrow, arrays) forward to these in
+// libstdc++ and libc++, aligned allocations are not counted.
+void * operator new(std::size_t size) {
+    GRAPH_LIB_COUNT(allocations, 1);
+    if (void * p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
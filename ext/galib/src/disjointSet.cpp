@@ -0,0 +1,69 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <numeric>
+#include "../include/disjointSet.h"
+
+namespace graph_lib {
+    DisjointSet::DisjointSet(unsigned int size) : parent(size), setSize(size, 1), setCount(size) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    unsigned int DisjointSet::find(unsigned int x) {
+        auto root = x;
+        while (parent[root] != root) root = parent[root];
+        // Point everything on the way straight at the root, so the next find is a single step.
+        while (parent[x] != root) {
+            auto next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    bool DisjointSet::unite(unsigned int a, unsigned int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        // Hang the smaller tree below the larger one, which keeps the trees logarithmically shallow.
+        if (setSize[a] < setSize[b]) std::swap(a, b);
+        parent[b] = a;
+        setSize[a] += setSize[b];
+        setCount--;
+        return true;
+    }
+
+    unsigned int DisjointSet::getSetSize(unsigned int x) {
+        return setSize[find(x)];
+    }
+
+    unsigned int DisjointSet::getSetCount() const {
+        return setCount;
+    }
+
+    Components DisjointSet::getComponents(unsigned int first) {
+        // Number the sets in order of their smallest element, then counting sort the elements into them.
+        const auto size = static_cast<unsigned int>(parent.size());
+        std::vector<unsigned int> componentOf(size, size);
+        std::vector<unsigned int> label(size, size);
+        Components output;
+        output.offsets.push_back(0);
+        for (auto x = first; x < size; x++) {
+            auto root = find(x);
+            if (label[root] == size) {
+                label[root] = output.offsets.size() - 1;
+                output.offsets.push_back(0);
+            }
+            componentOf[x] = label[root];
+            output.offsets[label[root] + 1]++;
+        }
+        std::partial_sum(output.offsets.begin(), output.offsets.end(), output.offsets.begin());
+        output.nodes.resize(size - std::min(first, size));
+        std::vector<unsigned int> cursor(output.offsets.begin(), output.offsets.end() - 1);
+        for (auto x = first; x < size; x++) {
+            output.nodes[cursor[componentOf[x]]++] = x;
+        }
+        return output;
+    }
+}
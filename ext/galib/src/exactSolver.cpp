@@ -0,0 +1,192 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include "../include/exactSolver.h"
+#include "../include/parallel.h"
+
+namespace graph_lib {
+    std::string PathSolution::getText() const {
+        std::string str = "[" + std::to_string(length) + " | ";
+        for (std::size_t i = 0; i < nodes.size(); i++){
+            if (i != 0) str += ", ";
+            str += std::to_string(nodes[i]);
+        }
+        return str + "]";
+    }
+
+    namespace {
+        // Subsets handed to one parallelFor call.
+        constexpr std::uint64_t dpBlockSize = 4096;
+
+        // Node i + 1 of the graph is bit i of a mask.
+        struct SubsetDp {
+            unsigned int n;
+            std::vector<std::uint32_t> adjacent;            // adjacent[i] = mask of the neighbours of bit i
+            std::vector<std::uint32_t> weight;              // weight[i * n + j]
+            std::vector<std::vector<std::uint64_t>> binomial;
+            std::vector<std::uint64_t> layerStart;          // Start of the entries for subsets of size k
+
+            explicit SubsetDp(const Graph & graph) : n(graph.getNodeCount()), adjacent(n, 0), weight(n * n, 0),
+                                                     binomial(n + 1, std::vector<std::uint64_t>(n + 1, 0)),
+                                                     layerStart(n + 2, 0) {
+                for (unsigned int i = 0; i < n; i++) {
+                    auto neighbours = graph.getNeighbours(i + 1);
+                    auto weights = graph.getWeights(i + 1);
+                    for (std::size_t k = 0; k < neighbours.size(); k++) {
+                        if (weights[k] < 0) throw std::invalid_argument("Edge weights need to be non-negative.");
+                        adjacent[i] |= std::uint32_t(1) << (neighbours[k] - 1);
+                        weight[i * n + neighbours[k] - 1] = weights[k];
+                    }
+                }
+                for (unsigned int i = 0; i <= n; i++) {
+                    binomial[i][0] = 1;
+                    for (unsigned int j = 1; j <= i; j++) binomial[i][j] = binomial[i - 1][j - 1] + binomial[i - 1][j];
+                }
+                // A subset of size k has an entry for each of its k possible endpoints.
+                for (unsigned int k = 1; k <= n; k++) layerStart[k + 1] = layerStart[k] + binomial[n][k] * k;
+            }
+
+            std::uint64_t entries() const { return layerStart[n + 1]; }
+
+            // Position of a k-subset in the colex order of all k-subsets, which is also the order Gosper's hack
+            // (next) walks through them.
+            std::uint64_t rank(std::uint32_t set) const {
+                std::uint64_t r = 0;
+                for (unsigned int i = 1; set; i++, set &= set - 1) r += binomial[std::countr_zero(set)][i];
+                return r;
+            }
+
+            std::uint32_t unrank(std::uint64_t r, unsigned int k) const {
+                std::uint32_t set = 0;
+                for (unsigned int i = k; i >= 1; i--) {
+                    unsigned int c = i - 1;
+                    while (c + 1 < n && binomial[c + 1][i] <= r) c++;
+                    r -= binomial[c][i];
+                    set |= std::uint32_t(1) << c;
+                }
+                return set;
+            }
+
+            static std::uint32_t next(std::uint32_t set) {
+                std::uint32_t lowest = set & -set;
+                std::uint32_t ripple = set + lowest;
+                return ripple | (((ripple ^ set) >> 2) / lowest);
+            }
+        };
+
+        struct DpBest {
+            std::uint64_t value = 0;
+            std::uint32_t set = 1;
+            unsigned int end = 0;
+        };
+
+        template<typename V>
+        PathSolution solve(const SubsetDp & dp, unsigned int threads) {
+            constexpr V unreachable = std::numeric_limits<V>::max();
+            const unsigned int n = dp.n;
+            std::vector<V> table(dp.entries(), unreachable);
+            auto at = [&](unsigned int k, std::uint64_t rank, unsigned int pos) -> V & {
+                return table[dp.layerStart[k] + rank * k + pos];
+            };
+
+            // A single node is a path of length 0.
+            for (unsigned int i = 0; i < n; i++) at(1, i, 0) = 0;
+            DpBest best;
+            std::mutex bestMutex;
+
+            for (unsigned int k = 2; k <= n; k++) {
+                const std::uint64_t subsets = dp.binomial[n][k];
+                const std::uint64_t blocks = (subsets + dpBlockSize - 1) / dpBlockSize;
+                parallelFor(blocks, [&](std::size_t block) {
+                    DpBest local;
+                    std::uint64_t r = block * dpBlockSize;
+                    const std::uint64_t last = std::min(subsets, r + dpBlockSize);
+                    std::uint32_t set = dp.unrank(r, k);
+                    unsigned int bits[32];
+                    std::uint64_t prefix[33], suffix[33];
+                    for (; r < last; r++, set = (r < last ? SubsetDp::next(set) : set)) {
+                        // rank(set \ bits[j]) = sum_{i<j} C(bits[i], i+1) + sum_{i>j} C(bits[i], i), for all j at once.
+                        unsigned int count = 0;
+                        for (auto s = set; s; s &= s - 1) bits[count++] = std::countr_zero(s);
+                        prefix[0] = 0;
+                        for (unsigned int i = 0; i < k; i++) prefix[i + 1] = prefix[i] + dp.binomial[bits[i]][i + 1];
+                        suffix[k] = 0;
+                        for (unsigned int i = k; i-- > 0;) suffix[i] = suffix[i + 1] + dp.binomial[bits[i]][i];
+
+                        for (unsigned int j = 0; j < k; j++) {
+                            const unsigned int v = bits[j];
+                            const std::uint32_t rest = set & ~(std::uint32_t(1) << v);
+                            const std::uint64_t restRank = prefix[j] + suffix[j + 1];
+                            V value = unreachable;
+                            for (auto from = rest & dp.adjacent[v]; from; from &= from - 1) {
+                                const unsigned int u = std::countr_zero(from);
+                                const auto pos = std::popcount(rest & ((std::uint32_t(1) << u) - 1));
+                                const V before = at(k - 1, restRank, pos);
+                                if (before == unreachable) continue;
+                                const V candidate = before + static_cast<V>(dp.weight[u * n + v]);
+                                if (value == unreachable || candidate > value) value = candidate;
+                            }
+                            at(k, r, j) = value;
+                            if (value != unreachable && value > local.value) local = {value, set, v};
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(bestMutex);
+                    if (local.value > best.value) best = local;
+                }, threads);
+            }
+
+            // Walk back from the best end: the previous node is a neighbour whose entry plus the edge gives our value.
+            PathSolution solution;
+            solution.length = best.value;
+            auto set = best.set;
+            auto end = best.end;
+            std::uint64_t value = best.value;
+            while (true) {
+                solution.nodes.push_back(end + 1);
+                const auto rest = set & ~(std::uint32_t(1) << end);
+                if (!rest) break;
+                const unsigned int k = std::popcount(rest);
+                const auto restRank = dp.rank(rest);
+                for (auto from = rest & dp.adjacent[end]; from; from &= from - 1) {
+                    const unsigned int u = std::countr_zero(from);
+                    const V before = at(k, restRank, std::popcount(rest & ((std::uint32_t(1) << u) - 1)));
+                    if (before != unreachable && before + dp.weight[u * n + end] == value) {
+                        value = before;
+                        end = u;
+                        break;
+                    }
+                }
+                set = rest;
+            }
+            std::reverse(solution.nodes.begin(), solution.nodes.end());
+            return solution;
+        }
+    }
+
+    PathSolution longestPathDp(const Graph & graph, unsigned int threads, std::size_t memoryLimit) {
+        const unsigned int n = graph.getNodeCount();
+        if (n > exactDpMaxNodes)
+            throw std::invalid_argument("The subset DP supports at most " + std::to_string(exactDpMaxNodes)
+                                        + " nodes, graph has " + std::to_string(n) + ".");
+        if (n == 0) return {};
+        SubsetDp dp(graph);
+
+        // No path is heavier than taking the heaviest edge at every node, so that decides the width of the entries.
+        std::uint64_t bound = 0;
+        for (unsigned int i = 0; i < n; i++) {
+            auto weights = graph.getWeights(i + 1);
+            if (!weights.empty()) bound += *std::max_element(weights.begin(), weights.end());
+        }
+        const bool narrow = bound < std::numeric_limits<std::uint16_t>::max();
+        const std::size_t bytes = dp.entries() * (narrow ? sizeof(std::uint16_t) : sizeof(std::uint32_t));
+        if (bytes > memoryLimit || bound >= std::numeric_limits<std::uint32_t>::max())
+            throw std::invalid_argument("The subset DP for this graph needs " + std::to_string(bytes)
+                                        + " bytes, more than the limit of " + std::to_string(memoryLimit) + ".");
+        return narrow ? solve<std::uint16_t>(dp, threads) : solve<std::uint32_t>(dp, threads);
+    }
+}
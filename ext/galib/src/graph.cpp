@@ -3,108 +3,344 @@
 //
 
 #include "../include/graph.h"
+#include "../include/counters.h"
 #include <stdexcept>
 #include <unordered_set>
+#include <algorithm>
 
 namespace graph_lib {
-    bool compareIndex(std::vector<unsigned int> I1, std::vector<unsigned int> I2){
-        return I1[0] < I2[0];
+    EdgeList toEdgeList(const std::vector<std::vector<unsigned int>> & input){
+        EdgeList edges;
+        edges.reserve(input.size());
+        for (const auto & line : input){
+            edges.push_back({line[0], line[1], line[2]});
+        }
+        return edges;
     }
 
-    void sortInput(std::vector<std::vector<unsigned int>> & input){
-        std::sort(input.begin(), input.end(), compareIndex);
+    PathDecoder parsePathDecoder(const std::string & name){
+        if (name == "stop" || name.empty()) return PathDecoder::Stop;
+        if (name == "repair") return PathDecoder::Repair;
+        if (name == "both") return PathDecoder::RepairBothWays;
+        throw std::invalid_argument("Unknown path decoder '" + name + "', expected stop, repair or both.");
     }
 
-    void inputFix (std::vector<std::vector<unsigned int>> & input){
-        int initSize = input.size();
-        for(auto i = 0; i< initSize; i++)
-        {
-            auto in = input[i];
-            input.push_back({in[1], in[0], in[2]});
-        }
-        sortInput(input); // but actually e.g. iterators
+    WeightType parseWeightType(const std::string & name){
+        if (name == "int" || name.empty()) return WeightType::Int;
+        if (name == "compact") return WeightType::Compact;
+        if (name == "auto") return WeightType::Auto;
+        throw std::invalid_argument("Unknown graph weight type '" + name + "', expected int, compact or auto.");
+    }
+
+    namespace {
+        // Backing store for adjacency arrays built in memory, as opposed to arrays that live in a mapped snapshot.
+        template <typename W>
+        struct OwnedAdjacency {
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::uint32_t> neighbours;
+            std::vector<W> weights;
+
+            BasicAdjacency<W> view() const {
+                return {offsets.data(), neighbours.data(), weights.data()};
+            }
+        };
+    }
+
+    template <typename W, typename L>
+    BasicGraph<W, L>::BasicGraph(const std::vector<std::vector<unsigned int>> & input, unsigned int nodes)
+        : BasicGraph(toEdgeList(input), nodes) {}
+
+    template <typename W, typename L>
+    BasicGraph<W, L>::BasicGraph(const EdgeList & input, unsigned int nodes) {
+        build(input, nodes);
+    }
+
+    template <typename W, typename L>
+    BasicGraph<W, L>::BasicGraph(const std::vector<BasicEdge<W>> & input, unsigned int nodes) {
+        build(input, nodes);
     }
 
-    Graph::Graph(std::vector<std::vector<unsigned int>> & input, unsigned int nodes) {
-        inputFix(input);
-        // make sure it's sorted!
+    template <typename W, typename L>
+    template <typename E>
+    void BasicGraph<W, L>::build(const std::vector<BasicEdge<E>> & input, unsigned int nodes) {
+        // Builds the adjacency with a two pass counting sort, which is O(nodes + edges) and leaves every row sorted
+        // by neighbour without comparing anything. Every undirected edge {u, v} gives the entries u -> v and v -> u.
         nodeCount = nodes;
-        edges = std::vector<std::unordered_map<unsigned int, int>>();
-        unsigned int iter = 0;
-        // Note our graph nodes are 1-indexed. This means we need an empty edge set for node 0 to fill the datastructure.
-        // However since index 0 should not be in the input, starting the loop at 0 will take care of that.
-        for (int index = 0; index <= nodes; index++){
-            // We make use of the fact that the input is sorted in the left vertex to be able to enforce that this does
-            // not grow after we finish building it for this vertex to avoid segmentation faults.
-            std::unordered_map<unsigned int, int> edgeMap = std::unordered_map<unsigned int, int>();
-            while (iter < input.size() && input[iter][0] == index){
-                // Add the next line of input to our graph by adding the edge.
-                edgeMap.insert({input[iter][1], input[iter][2]});
-                iter++;
+        std::vector<std::uint32_t> degree(nodes + 2, 0);
+        for (const auto & edge : input){
+            if (edge.u > nodes || edge.v > nodes || edge.u == 0 || edge.v == 0){
+                throw std::invalid_argument("edge endpoint was not in graph!");
+            }
+            if (edge.u == edge.v) continue;
+            degree[edge.u]++;
+            degree[edge.v]++;
+        }
+        // Row i of the adjacency starts at offsets[i]. Since the edges are symmetric, the number of entries pointing
+        // *to* i equals the degree of i as well, so the same offsets bucket the entries by neighbour.
+        auto store = std::make_shared<OwnedAdjacency<W>>();
+        store->offsets.assign(nodes + 2, 0);
+        for (unsigned int i = 1; i <= nodes; i++){
+            store->offsets[i + 1] = store->offsets[i] + degree[i];
+        }
+        std::size_t entries = store->offsets[nodes + 1];
+
+        // First pass: bucket the entries by neighbour, storing (source, weight), keeping input order within a bucket.
+        std::vector<std::pair<std::uint32_t, W>> byNeighbour(entries);
+        std::vector<std::uint32_t> cursor(store->offsets.begin(), store->offsets.end());
+        for (const auto & edge : input){
+            if (edge.u == edge.v) continue;
+            auto weight = narrowWeight<W>(edge.w);
+            byNeighbour[cursor[edge.v]++] = {edge.u, weight};
+            byNeighbour[cursor[edge.u]++] = {edge.v, weight};
+        }
+
+        // Second pass: walk the neighbours in ascending order and scatter into the source rows, which are therefore
+        // filled in ascending neighbour order.
+        store->neighbours.resize(entries);
+        store->weights.resize(entries);
+        std::copy(store->offsets.begin(), store->offsets.end(), cursor.begin());
+        for (unsigned int neighbour = 1; neighbour <= nodes; neighbour++){
+            for (auto k = store->offsets[neighbour]; k < store->offsets[neighbour + 1]; k++){
+                auto [source, weight] = byNeighbour[k];
+                store->neighbours[cursor[source]] = neighbour;
+                store->weights[cursor[source]] = weight;
+                cursor[source]++;
             }
-            edges.push_back(edgeMap);
         }
-    }
 
-    void Graph::oneify(){
-        for (auto & edgeset : edges){
-            for (auto & it : edgeset){
-                it.second = 1;
+        // Duplicate edges end up next to each other within a row, only keep the first one given in the input.
+        std::uint32_t write = 0;
+        for (unsigned int i = 0; i <= nodes; i++){
+            auto rowStart = write;
+            for (auto k = store->offsets[i]; k < store->offsets[i + 1]; k++){
+                if (write > rowStart && store->neighbours[write - 1] == store->neighbours[k]) continue;
+                store->neighbours[write] = store->neighbours[k];
+                store->weights[write] = store->weights[k];
+                write++;
             }
+            store->offsets[i] = rowStart;
         }
+        store->offsets[nodes + 1] = write;
+        store->neighbours.resize(write);
+        store->weights.resize(write);
+
+        // Equal weights carry no information (that includes having no edges at all), drop them and keep only the
+        // topology.
+        const bool uniform = std::all_of(store->weights.begin(), store->weights.end(),
+                                         [&](W w) { return w == store->weights[0]; });
+        const W weight = write > 0 ? store->weights[0] : W(0);
+        if (uniform) std::vector<W>().swap(store->weights);
+        edges = store->view();
+        owner = std::move(store);
+        if (uniform) makeUniform(weight);
+    }
+
+    template <typename W, typename L>
+    BasicGraph<W, L>::BasicGraph(unsigned int nodes, BasicAdjacency<W> adjacency, std::shared_ptr<const void> owner)
+        : owner(std::move(owner)), edges(adjacency), nodeCount(nodes) {
+        if (edges.weights == nullptr) makeUniform(edges.uniformWeight);
+    }
+
+    template <typename W, typename L>
+    void BasicGraph<W, L>::makeUniform(W weight){
+        unsigned int maxDegree = 0;
+        for (unsigned int i = 1; i <= nodeCount; i++) maxDegree = std::max(maxDegree, getDegree(i));
+        edges.weights = nullptr;
+        edges.uniformWeight = weight;
+        uniformRow = std::make_shared<const std::vector<W>>(maxDegree, weight);
+    }
+
+    template <typename W, typename L>
+    void BasicGraph<W, L>::oneify(){
+        // Only the weights change, so the offsets and neighbours stay shared with other graphs or a mapped snapshot.
+        makeUniform(1);
+    }
+
+    template <typename W, typename L>
+    bool BasicGraph<W, L>::hasUniformWeights() const {
+        return edges.weights == nullptr;
     }
 
     // This function returns the weight of an edge, or -1 if it's not included in the graph. This assumes that
     // weights are >= 0.
-    int Graph::getEdge(unsigned int i, unsigned int j) const {
+    template <typename W, typename L>
+    typename BasicGraph<W, L>::EdgeWeight BasicGraph<W, L>::getEdge(unsigned int i, unsigned int j) const {
         if (i > nodeCount || j > nodeCount){
             throw std::invalid_argument("node was not in graph!");
         }
-        if (i < j){
-            if (edges[i].contains(j)) return edges[i].at(j);
-        } else {
-            if (edges[j].contains(i)) return edges[j].at(i);
+        GRAPH_LIB_COUNT(edgeLookups, 1);
+        auto row = getNeighbours(i);
+        auto it = std::lower_bound(row.begin(), row.end(), j);
+        if (it == row.end() || *it != j) return -1;
+        return edges.weights ? edges.weights[edges.offsets[i] + (it - row.begin())] : edges.uniformWeight;
+    }
+
+    template <typename W, typename L>
+    std::unordered_map<unsigned int, W> BasicGraph<W, L>::getNodeEdgeSet(unsigned int i) const{
+        std::unordered_map<unsigned int, W> edgeMap;
+        for (auto k = edges.offsets[i]; k < edges.offsets[i + 1]; k++){
+            edgeMap.insert({edges.neighbours[k], edges.weights ? edges.weights[k] : edges.uniformWeight});
         }
-        return -1;
+        return edgeMap;
+    }
+
+    template <typename W, typename L>
+    std::span<const std::uint32_t> BasicGraph<W, L>::getNeighbours(unsigned int i) const {
+        return {edges.neighbours + edges.offsets[i], edges.neighbours + edges.offsets[i + 1]};
     }
 
-    std::unordered_map<unsigned int, int> Graph::getNodeEdgeSet(unsigned int i) const{
-        return edges[i];
+    template <typename W, typename L>
+    std::span<const W> BasicGraph<W, L>::getWeights(unsigned int i) const {
+        if (!edges.weights) return {uniformRow->data(), getDegree(i)};
+        return {edges.weights + edges.offsets[i], edges.weights + edges.offsets[i + 1]};
     }
 
-    unsigned int Graph::getNodeCount() const {
+    template <typename W, typename L>
+    unsigned int BasicGraph<W, L>::getDegree(unsigned int i) const {
+        return edges.offsets[i + 1] - edges.offsets[i];
+    }
+
+    template <typename W, typename L>
+    unsigned int BasicGraph<W, L>::getNodeCount() const {
         return nodeCount;
     }
 
-    unsigned int Graph::getRandomEdge(unsigned int i, std::mt19937 & gen) const {
-        auto r = getNodeEdgeSet(i);
-        auto r0 = r;
-        std::vector<std::pair<unsigned int, int>> returnable;
-        std::sample(r.begin(), r.end(), std::back_inserter(returnable), 1, gen);
-        return returnable[0].first;
+    template <typename W, typename L>
+    std::size_t BasicGraph<W, L>::getEntryCount() const {
+        return edges.offsets[nodeCount + 1];
+    }
+
+    template <typename W, typename L>
+    const BasicAdjacency<W> & BasicGraph<W, L>::getAdjacency() const {
+        return edges;
+    }
+
+    template <typename W, typename L>
+    unsigned int BasicGraph<W, L>::getRandomEdge(unsigned int i, std::mt19937 & gen) const {
+        auto row = getNeighbours(i);
+        if (row.empty()) return 0; // Node 0 is never in the graph, so a preference for it always ends the path.
+        return row[std::uniform_int_distribution<std::size_t>(0, row.size() - 1)(gen)];
     }
 
     //This function will return a path and it's length. The length is encoded in path[0], the vertices visited are
     // [1..n] where n is the total vertices in path.
-    std::vector<unsigned int> Graph::computePath(const std::vector<unsigned int> & prefs) const{
+    template <typename W, typename L>
+    std::vector<unsigned int> BasicGraph<W, L>::computePath(const std::vector<unsigned int> & prefs) const{
+        std::vector<unsigned int> path{0};
+        path[0] = static_cast<unsigned int>(decode(prefs, &path));
+        return path;
+    }
+
+    template <typename W, typename L>
+    L BasicGraph<W, L>::computePathLength(const std::vector<unsigned int> & prefs) const{
+        return decode(prefs, nullptr);
+    }
+
+    template <typename W, typename L>
+    L BasicGraph<W, L>::computeRepairedPath(const std::vector<unsigned int> & prefs, DecodeBuffer & buffer,
+                                            bool extendBackward) const{
+        GRAPH_LIB_COUNT(decodes, 1);
+        auto & visited = buffer.visited;
+        if (visited.size() < nodeCount + 1) visited.assign(nodeCount + 1, 0);
+        if (++buffer.epoch == 0) {
+            std::fill(visited.begin(), visited.end(), 0);
+            buffer.epoch = 1;
+        }
+        const auto mark = buffer.epoch;
+        buffer.forward.clear();
+        buffer.backward.clear();
+        buffer.path.clear();
+
+        // The first unvisited neighbour of current, trying preferred first and then the rest of the row after where
+        // preferred is or would be. Returns the position in the row, or the degree if all are visited.
+        auto pick = [&](unsigned int current, unsigned int preferred) {
+            auto row = getNeighbours(current);
+            const std::size_t first = std::lower_bound(row.begin(), row.end(), preferred) - row.begin();
+            for (std::size_t i = 0; i < row.size(); i++) {
+                GRAPH_LIB_COUNT(edgeLookups, 1);
+                auto k = first + i < row.size() ? first + i : first + i - row.size();
+                if (visited[row[k]] != mark) return k;
+            }
+            return row.size();
+        };
+        auto weight = [&](unsigned int current, std::size_t k) {
+            return static_cast<L>(edges.weights ? edges.weights[edges.offsets[current] + k] : edges.uniformWeight);
+        };
+
+        const unsigned int start = prefs[0];
+        L length = 0;
+        visited[start] = mark;
+        buffer.forward.push_back(start);
+        for (auto current = start;;) {
+            auto k = pick(current, prefs[current]);
+            if (k == getDegree(current)) break;
+            length += weight(current, k);
+            current = edges.neighbours[edges.offsets[current] + k];
+            visited[current] = mark;
+            buffer.forward.push_back(current);
+        }
+        for (auto current = start; extendBackward;) {
+            auto row = getNeighbours(current);
+            auto k = row.size();
+            for (std::size_t i = 0; i < row.size() && k == row.size(); i++) {
+                GRAPH_LIB_COUNT(edgeLookups, 1);
+                if (visited[row[i]] != mark && prefs[row[i]] == current) k = i;
+            }
+            if (k == row.size()) k = pick(current, prefs[current]);
+            if (k == row.size()) break;
+            length += weight(current, k);
+            current = row[k];
+            visited[current] = mark;
+            buffer.backward.push_back(current);
+        }
+        GRAPH_LIB_COUNT(decodeSteps, buffer.forward.size() + buffer.backward.size());
+        buffer.path.insert(buffer.path.end(), buffer.backward.rbegin(), buffer.backward.rend());
+        buffer.path.insert(buffer.path.end(), buffer.forward.begin(), buffer.forward.end());
+        return length;
+    }
+
+    template <typename W, typename L>
+    L BasicGraph<W, L>::decode(const std::vector<unsigned int> & prefs, std::vector<unsigned int> * path) const{
+        GRAPH_LIB_COUNT(decodes, 1);
         std::unordered_set<unsigned int> visited = std::unordered_set<unsigned int>(prefs.size());
         unsigned int current = prefs[0]; // Our nodes are all 1-indexed, meaning the 0th index is free to put as a start node.
-        std::vector<unsigned int> path{0};
+        if (!edges.weights) {
+            // Without weights a step only needs its edge to exist, the length follows from the number of steps.
+            L steps = 0;
+            while (true) {
+                GRAPH_LIB_COUNT(decodeSteps, 1);
+                GRAPH_LIB_COUNT(edgeLookups, 1);
+                visited.insert(current);
+                if (path) path->push_back(current);
+                auto next = prefs[current];
+                auto row = getNeighbours(current);
+                if (!std::binary_search(row.begin(), row.end(), next) || visited.contains(next)) break;
+                current = next;
+                steps++;
+            }
+            return steps * static_cast<L>(edges.uniformWeight);
+        }
+        L length = 0;
         while (true) {
             // We build the path starting at node, then going to prefs[node], e.g. hopping along the preferred edge at
             // each stage. This is valid so long that node has not been visited yet, hence the visited check.
+            GRAPH_LIB_COUNT(decodeSteps, 1);
             visited.insert(current);
-            path.push_back(current);
-            int w = getEdge(current, prefs[current]);
+            if (path) path->push_back(current);
+            auto w = getEdge(current, prefs[current]);
             if (w >= 0 && !visited.contains(prefs[current])){
-                path[0] +=w;
+                length += static_cast<L>(w);
                 current = prefs[current];
                 continue;   // If we successfully found a new node to add to the path (the if statement), do so
                             // and iterate the loop, which is what continue does.
             }
             break; // the default behaviour is to break, which feels slightly safer, ending the while loop.
         }
-        return path;
+        return length;
     }
 
+    template class BasicGraph<std::int32_t, unsigned int>;
+    template class BasicGraph<std::uint16_t, std::uint64_t>;
+    template class BasicGraph<float, double>;
+    template class BasicGraph<double, double>;
 }
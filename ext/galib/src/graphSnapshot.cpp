@@ -0,0 +1,192 @@
+//
+// Created on 18/10/2026.
+//
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/graphSnapshot.h"
+#include "../include/testGraphs.h"
+
+namespace graph_lib {
+    namespace {
+        constexpr char snapshotMagic[8] = {'G', 'L', 'S', 'N', 'A', 'P', 0, 0};
+        constexpr std::uint64_t snapshotAlignment = 64;
+
+        std::uint64_t alignUp(std::uint64_t pos) {
+            return (pos + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment;
+        }
+
+        // FNV-1a, but eating 8 bytes per round instead of 1 so checking a large snapshot stays cheap.
+        std::uint64_t hashBytes(std::uint64_t hash, const void * data, std::size_t length) {
+            auto bytes = static_cast<const unsigned char *>(data);
+            std::size_t i = 0;
+            for (; i + 8 <= length; i += 8) {
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i, 8);
+                hash = (hash ^ word) * 0x100000001b3ULL;
+            }
+            for (; i < length; i++) {
+                hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+        std::uint64_t adjacencyChecksum(unsigned int nodes, std::uint64_t entries, const Adjacency & adjacency) {
+            std::uint64_t hash = 0xcbf29ce484222325ULL;
+            hash = hashBytes(hash, &nodes, sizeof(nodes));
+            hash = hashBytes(hash, adjacency.offsets, (nodes + 2) * sizeof(std::uint32_t));
+            hash = hashBytes(hash, adjacency.neighbours, entries * sizeof(std::uint32_t));
+            if (adjacency.weights)
+                hash = hashBytes(hash, adjacency.weights, entries * sizeof(std::int32_t));
+            else
+                hash = hashBytes(hash, &adjacency.uniformWeight, sizeof(adjacency.uniformWeight));
+            return hash;
+        }
+
+        // Whether the arrays form an adjacency that can be walked without reading out of bounds: the offsets start at
+        // 0, never decrease and end at entries, and every row holds ascending node ids in [1, nodes]. Takes
+        // O(nodes + entries).
+        bool validAdjacency(unsigned int nodes, std::uint64_t entries, const Adjacency & adjacency) {
+            if (adjacency.offsets[0] != 0 || adjacency.offsets[1] != 0 || adjacency.offsets[nodes + 1] != entries)
+                return false;
+            for (std::uint64_t i = 1; i <= nodes; i++) {
+                const auto begin = adjacency.offsets[i], end = adjacency.offsets[i + 1];
+                if (end < begin) return false;
+                for (auto k = begin; k < end; k++) {
+                    const auto v = adjacency.neighbours[k];
+                    if (v == 0 || v > nodes || (k > begin && v <= adjacency.neighbours[k - 1])) return false;
+                }
+            }
+            return true;
+        }
+
+        // Owns a read-only mapping of a whole file, graphs loaded from it keep this alive.
+        struct MappedFile {
+            void * address = MAP_FAILED;
+            std::size_t length = 0;
+
+            ~MappedFile() {
+                if (address != MAP_FAILED) munmap(address, length);
+            }
+        };
+
+        void writePadding(std::ofstream & out, std::uint64_t pos) {
+            static const char zeroes[snapshotAlignment] = {};
+            out.write(zeroes, static_cast<std::streamsize>(pos - static_cast<std::uint64_t>(out.tellp())));
+        }
+    }
+
+    std::uint64_t adjacencyChecksum(const Graph & graph) {
+        return adjacencyChecksum(graph.getNodeCount(), graph.getEntryCount(), graph.getAdjacency());
+    }
+
+    void saveGraphSnapshot(const Graph & graph, const std::string & filename) {
+        const auto & adjacency = graph.getAdjacency();
+        SnapshotHeader header{};
+        std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+        header.version = snapshotVersion;
+        header.nodeCount = graph.getNodeCount();
+        header.entryCount = graph.getEntryCount();
+        header.offsetsPos = alignUp(sizeof(SnapshotHeader));
+        header.neighboursPos = alignUp(header.offsetsPos + (header.nodeCount + 2) * sizeof(std::uint32_t));
+        header.fileSize = header.neighboursPos + header.entryCount * sizeof(std::uint32_t);
+        if (adjacency.weights) {
+            header.weightsPos = alignUp(header.fileSize);
+            header.fileSize = header.weightsPos + header.entryCount * sizeof(std::int32_t);
+        }
+        header.uniformWeight = adjacency.uniformWeight;
+        header.checksum = adjacencyChecksum(graph);
+
+        // Write next to the destination and rename afterwards, rename is atomic within a filesystem.
+        auto temporary = filename + ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Could not open " + temporary + " for writing.");
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            writePadding(out, header.offsetsPos);
+            out.write(reinterpret_cast<const char *>(adjacency.offsets),
+                      static_cast<std::streamsize>((header.nodeCount + 2) * sizeof(std::uint32_t)));
+            writePadding(out, header.neighboursPos);
+            out.write(reinterpret_cast<const char *>(adjacency.neighbours),
+                      static_cast<std::streamsize>(header.entryCount * sizeof(std::uint32_t)));
+            if (adjacency.weights) {
+                writePadding(out, header.weightsPos);
+                out.write(reinterpret_cast<const char *>(adjacency.weights),
+                          static_cast<std::streamsize>(header.entryCount * sizeof(std::int32_t)));
+            }
+            if (!out) throw std::runtime_error("Could not write snapshot " + temporary + ".");
+        }
+        std::filesystem::rename(temporary, filename);
+    }
+
+    Graph loadGraphSnapshot(const std::string & filename, bool verifyChecksum) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Could not open snapshot " + filename + ".");
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(SnapshotHeader)) {
+            close(fd);
+            throw std::runtime_error("Snapshot " + filename + " is too small to contain a header.");
+        }
+        auto file = std::make_shared<MappedFile>();
+        file->length = info.st_size;
+        file->address = mmap(nullptr, file->length, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd); // The mapping stays valid after closing the descriptor.
+        if (file->address == MAP_FAILED) throw std::runtime_error("Could not map snapshot " + filename + ".");
+
+        auto base = static_cast<const char *>(file->address);
+        SnapshotHeader header{};
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) != 0)
+            throw std::runtime_error(filename + " is not a graph snapshot.");
+        if (header.version != snapshotVersion)
+            throw std::runtime_error("Snapshot " + filename + " has version " + std::to_string(header.version)
+                                     + ", expected " + std::to_string(snapshotVersion) + ".");
+        const auto neighboursEnd = header.neighboursPos + header.entryCount * sizeof(std::uint32_t);
+        // Every position and count is bounded by the file length first, so the sums below cannot overflow.
+        if (header.fileSize != file->length || header.entryCount > file->length / sizeof(std::uint32_t)
+            || header.offsetsPos > file->length || header.neighboursPos > file->length
+            || header.weightsPos > file->length
+            || header.offsetsPos % alignof(std::uint32_t) != 0 || header.neighboursPos % alignof(std::uint32_t) != 0
+            || header.weightsPos % alignof(std::int32_t) != 0
+            || header.offsetsPos < sizeof(SnapshotHeader)
+            || header.offsetsPos + (header.nodeCount + 2) * sizeof(std::uint32_t) > header.neighboursPos
+            || neighboursEnd > (header.weightsPos != 0 ? header.weightsPos : header.fileSize)
+            || (header.weightsPos != 0
+                && header.weightsPos + header.entryCount * sizeof(std::int32_t) > header.fileSize))
+            throw std::runtime_error("Snapshot " + filename + " is truncated or corrupt.");
+
+        Adjacency adjacency{reinterpret_cast<const std::uint32_t *>(base + header.offsetsPos),
+                            reinterpret_cast<const std::uint32_t *>(base + header.neighboursPos),
+                            header.weightsPos != 0 ? reinterpret_cast<const std::int32_t *>(base + header.weightsPos)
+                                                   : nullptr,
+                            header.uniformWeight};
+        if (!validAdjacency(header.nodeCount, header.entryCount, adjacency))
+            throw std::runtime_error("Snapshot " + filename + " is truncated or corrupt.");
+        if (verifyChecksum && adjacencyChecksum(header.nodeCount, header.entryCount, adjacency) != header.checksum)
+            throw std::runtime_error("Snapshot " + filename + " failed its checksum.");
+        return {header.nodeCount, adjacency, std::move(file)};
+    }
+
+    Graph getGraphByTypeCached(int i, int param, double param2, int seed, const std::string & directory) {
+        if (directory.empty()) return getGraphByType(i, param, param2, seed);
+
+        // Full precision, so generator parameters that differ only in later digits get their own snapshots.
+        std::ostringstream name;
+        name << std::setprecision(std::numeric_limits<double>::max_digits10) << "graph_t" << i << "_n" << param << "_p"
+             << param2 << "_s" << seed << "_v" << snapshotVersion << ".glsnap";
+        auto path = (std::filesystem::path(directory) / name.str()).string();
+        if (!std::filesystem::exists(path)) {
+            std::filesystem::create_directories(directory);
+            saveGraphSnapshot(getGraphByType(i, param, param2, seed), path);
+        }
+        return loadGraphSnapshot(path);
+    }
+}
@@ -0,0 +1,46 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../include/parallel.h"
+
+namespace graph_lib {
+    unsigned int defaultThreadCount() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> & body, unsigned int threads) {
+        if (threads == 0) threads = defaultThreadCount();
+        threads = static_cast<unsigned int>(std::min<std::size_t>(threads, count));
+        if (threads <= 1) {
+            for (std::size_t i = 0; i < count; i++) body(i);
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+        auto worker = [&]() {
+            for (auto i = next++; i < count; i = next++) {
+                try {
+                    body(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure) failure = std::current_exception();
+                    next = count; // Stop handing out work.
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned int t = 1; t < threads; t++) pool.emplace_back(worker);
+        worker();
+        for (auto & thread : pool) thread.join();
+        if (failure) std::rethrow_exception(failure);
+    }
+}
@@ -0,0 +1,147 @@
+//
+// Created on 18/10/2026.
+//
+#include "../include/perfCounters.h"
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace graph_lib {
+    PerfSample PerfSample::operator-(const PerfSample & other) const {
+        PerfSample result;
+        for (std::size_t i = 0; i < perfEventCount; i++) {
+            if (values[i] >= 0 && other.values[i] >= 0) result.values[i] = values[i] - other.values[i];
+        }
+        return result;
+    }
+
+    PerfSample & PerfSample::operator+=(const PerfSample & other) {
+        for (std::size_t i = 0; i < perfEventCount; i++) {
+            values[i] = values[i] >= 0 && other.values[i] >= 0 ? values[i] + other.values[i] : -1;
+        }
+        return *this;
+    }
+
+    double PerfSample::ipc() const {
+        if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions) || (*this)[PerfEvent::Cycles] == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+        return static_cast<double>((*this)[PerfEvent::Instructions]) / static_cast<double>((*this)[PerfEvent::Cycles]);
+    }
+
+    double PerfSample::per(PerfEvent event, std::uint64_t work) const {
+        if (!has(event) || work == 0) return std::numeric_limits<double>::quiet_NaN();
+        return static_cast<double>((*this)[event]) / static_cast<double>(work);
+    }
+
+    std::string PerfSample::summary(std::uint64_t decodeSteps) const {
+        std::ostringstream out;
+        if (std::isnan(ipc())) {
+            out << "no cycle counts";
+        } else {
+            out << "ipc " << ipc();
+        }
+        // Decode steps are only counted in GAL_INSTRUMENT builds, say so instead of leaving the ratios out silently.
+        if (decodeSteps > 0) {
+            for (auto event : {PerfEvent::L1Misses, PerfEvent::LlcMisses, PerfEvent::BranchMisses}) {
+                if (has(event)) out << ", " << perfEventNames[static_cast<std::size_t>(event)] << "/step "
+                                    << per(event, decodeSteps);
+            }
+        } else {
+            out << ", misses per decode step need a build with -DGAL_INSTRUMENT=ON";
+        }
+        return out.str();
+    }
+
+#ifdef __linux__
+    namespace {
+        perf_event_attr eventAttr(PerfEvent event) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            switch (event) {
+                case PerfEvent::Cycles: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+                case PerfEvent::Instructions: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+                case PerfEvent::L1Misses:
+                    attr.type = PERF_TYPE_HW_CACHE;
+                    attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                    break;
+                case PerfEvent::LlcMisses: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+                case PerfEvent::BranchMisses: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+            }
+            // User space only, which perf_event_paranoid 2 still allows.
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return attr;
+        }
+    }
+
+    PerfCounters::PerfCounters() {
+        fds.fill(-1);
+        for (std::size_t i = 0; i < perfEventCount; i++) {
+            auto attr = eventAttr(static_cast<PerfEvent>(i));
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[i] < 0 && failure.empty()) {
+                failure = std::string(perfEventNames[i]) + ": " + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) failure += " (see /proc/sys/kernel/perf_event_paranoid)";
+                if (errno == ENOENT || errno == EOPNOTSUPP) failure += " (no hardware counters, e.g. in a VM)";
+            }
+        }
+    }
+
+    PerfCounters::~PerfCounters() {
+        for (auto fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    PerfSample PerfCounters::read() const {
+        PerfSample sample;
+        for (std::size_t i = 0; i < perfEventCount; i++) {
+            std::uint64_t data[3]; // value, time enabled, time running
+            if (fds[i] < 0 || ::read(fds[i], data, sizeof(data)) != sizeof(data)) continue;
+            // An event that never got a hardware counter has no value to scale.
+            if (data[2] == 0) {
+                sample.values[i] = data[1] == 0 ? 0 : -1;
+                continue;
+            }
+            sample.values[i] = static_cast<std::int64_t>(
+                    static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]));
+        }
+        return sample;
+    }
+#else
+    PerfCounters::PerfCounters() : failure("perf_event_open needs Linux") {
+        fds.fill(-1);
+    }
+
+    PerfCounters::~PerfCounters() = default;
+
+    PerfSample PerfCounters::read() const {
+        return {};
+    }
+#endif
+
+    bool PerfCounters::available() const {
+        for (auto fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    const std::string & PerfCounters::reason() const {
+        return failure;
+    }
+}
@@ -1,10 +1,12 @@
 //
 // Created by emi on 09/12/2021.
 //
-#include <list>
 #include <algorithm>
 #include <ctgmath>
 #include <random>
+#include <limits>
+#include <numeric>
+#include "../include/parallel.h"
 #include "../include/randomGraph.h"
 
 namespace graph_lib{
@@ -18,38 +20,27 @@ namespace graph_lib{
             for (auto entry : input2) {
                 std::vector<unsigned int> addendum; // Turn edges from c-graph edges into edges in our real graph.
                 // entry = {i', j', w}, i' and j'  are the connected components number, or nodes in the c-graph
-                std::sample(concomp[entry[0]-1].begin(), concomp[entry[0]-1].end(), std::back_inserter(addendum), 1, gen); // Select i
-                std::sample(concomp[entry[1]-1].begin(), concomp[entry[1]-1].end(), std::back_inserter(addendum), 1, gen); // Select j
+                std::sample(concomp[entry.u-1].begin(), concomp[entry.u-1].end(), std::back_inserter(addendum), 1, gen); // Select i
+                std::sample(concomp[entry.v-1].begin(), concomp[entry.v-1].end(), std::back_inserter(addendum), 1, gen); // Select j
                 sort(addendum.begin(), addendum.end()); //Make sure i < j.
-                addendum.push_back(entry[2]); // Select w.
-                input.push_back(addendum); // Add the new edge into our main input.
+                input.push_back({addendum[0], addendum[1], entry.w}); // Add the new edge into our main input.
             }
-            sortInput(input); // Sort because we require sorted list of edges for memory segmentation reasons.
-            concomp.clear();
             concomp = findConnectedComponents(input, nodes);
         }
         return Graph(input, nodes);
     }
 
-    template<typename T>
-    bool sizeCompare(std::vector<T> a, std::vector<T> b){
-        return a.size() < b.size();
-    }
-
-    unsigned int determineGenSize(unsigned int nodes, double p){
-        double np = nodes*p;
-        if (np >= 1.1) return nodes;
-        if (np > 0.9 && np < 1.1) return (unsigned int)(0.5 * nodes * sqrt(nodes)); //possibly tune to a better fitting constant.
-        if (np <= 0.9) return std::max(1<<31, 1<<(nodes-1)); // This sounds really freaky, but the size will be log(this)...
-    }
-
     Graph erdosGraphRejection(unsigned int nodes, double p, int seed) {
         srand(seed);
         unsigned int genSize = nodes;
         while (true){
             auto input = erdosInputGen(genSize, p, rand());
             auto concomp = findConnectedComponents(input, genSize);
-            auto largestcomp = *std::max_element(concomp.begin(), concomp.end(), sizeCompare<unsigned int>);
+            std::size_t largest = 0;
+            for (std::size_t c = 1; c < concomp.size(); c++) {
+                if (concomp[c].size() > concomp[largest].size()) largest = c;
+            }
+            auto largestcomp = concomp[largest];
             // Found largest component of random graph of size n^3/2, if its correct size, output.
             if (largestcomp.size() == nodes){
                 std::unordered_map<unsigned int, unsigned int> indexFixer = std::unordered_map<unsigned int, unsigned int>();
@@ -57,11 +48,11 @@ namespace graph_lib{
                 {
                     indexFixer.emplace(largestcomp[i-1], i);
                 } //indexFixer is a "index transform" from graph of size n^3/2 to the graph we want.
-                std::vector<std::vector<unsigned int>> newInput;
+                EdgeList newInput;
                 for (auto entry : input){ //For each edge in the n^3/2 graph, check if both i and j are in the index transform.
-                    if (indexFixer.contains(entry[0]) && indexFixer.contains(entry[1])){
-                        std::vector<unsigned int> newEdge = {indexFixer[entry[0]], indexFixer[entry[1]], entry[2]};
-                        newInput.push_back(newEdge); //if it is contained, build a new edge like t(i), t(j), w.
+                    if (indexFixer.contains(entry.u) && indexFixer.contains(entry.v)){
+                        //if it is contained, build a new edge like t(i), t(j), w.
+                        newInput.push_back({indexFixer[entry.u], indexFixer[entry.v], entry.w});
                     }
                 }
                 return Graph(newInput, nodes);
@@ -72,14 +63,18 @@ namespace graph_lib{
         }
     }
 
-    std::vector<std::vector<unsigned int>> erdosInputGen(unsigned int nodes, double p, int seed) {
-        std::vector<std::vector<unsigned int>> data = std::vector<std::vector<unsigned int>>();
+    EdgeList erdosInputGen(unsigned int nodes, double p, int seed) {
+        EdgeList data = EdgeList();
+        data.reserve(static_cast<std::size_t>(p * nodes * (nodes - 1) / 2));
         srand(seed);
+        // nodes * nodes overflows from 65536 nodes on, keep the weights within what a Graph can store.
+        const auto maxWeight = std::max<std::uint64_t>(
+                std::min<std::uint64_t>(std::uint64_t(nodes) * nodes, std::numeric_limits<std::int32_t>::max()), 1);
         for (unsigned int xi = 1; xi <= nodes; xi++) {
             for (unsigned int yi = xi + 1; yi <= nodes; yi++) {
                 auto r = static_cast<float> (rand() / static_cast<float> (RAND_MAX));
                 if (r < p) {
-                    auto w = rand() % (nodes*nodes);
+                    auto w = static_cast<std::uint32_t>(rand() % maxWeight);
                     data.push_back({xi, yi, w+1});
                 }
             }
@@ -87,59 +82,116 @@ namespace graph_lib{
         return data;
     }
 
-    bool listContains(std::vector<unsigned int> haystack, unsigned int needle){
-        return std::find(haystack.begin(), haystack.end(), needle) != haystack.end();
+    namespace {
+        // Number of node pairs one chunk of erdosInputGenSkip covers. Fixed, so the chunks and thereby the output only
+        // depend on the seed and not on the number of threads.
+        constexpr std::uint64_t skipChunkPairs = std::uint64_t(1) << 24;
+
+        // Weights are drawn from [1, nodes * nodes], at most weightLimit (if given) and what fits a Graph weight.
+        std::uint32_t defaultMaxWeight(unsigned int nodes, std::uint32_t weightLimit) {
+            std::uint64_t maxWeight = std::min<std::uint64_t>(std::uint64_t(nodes) * nodes,
+                                                              std::numeric_limits<std::int32_t>::max());
+            if (weightLimit != 0) maxWeight = std::min<std::uint64_t>(maxWeight, weightLimit);
+            return static_cast<std::uint32_t>(std::max<std::uint64_t>(maxWeight, 1));
+        }
     }
 
-    std::vector<std::vector<unsigned int>> findConnectedComponents(std::vector<std::vector<unsigned int>> input, unsigned int nodes) {
-        std::vector<bool> visited = std::vector<bool>(nodes+1);
-        std::list<std::vector<unsigned int>> output;
-        for (auto line : input) {
-            if (visited[line[1]]) {
-                auto iterSecond = output.begin(); // the connected component containing line[1].
-                while (iterSecond != output.end() && !listContains(*iterSecond, line[1])) {
-                    iterSecond++;
-                }
-                if (visited[line[0]]){ // merge or ignore
-                    auto iterFirst = output.begin(); // the connected component containing line[0]
-                    while (iterFirst != output.end() && !listContains(*iterFirst, line[0])) {
-                        iterFirst++;
-                    }
-                    if (iterFirst != iterSecond) { // If components area different, else do nothing.
-                        for (auto node: *iterFirst) {
-                            (*iterSecond).push_back(node);
-                        }
-                        output.remove(*iterFirst);
-                    }
-                }
-                else{ // add
-                    (*iterSecond).push_back(line[0]);
-                    visited[line[0]] = true;
-                }
-            }
-            else {
-                auto iterSecond = output.begin(); // the connected component containing line[1]
-                while (iterSecond != output.end() && !listContains(*iterSecond, line[0])) {
-                    iterSecond++;
+    EdgeList erdosInputGenSkip(unsigned int nodes, double p, int seed, unsigned int threads,
+                               std::uint32_t weightLimit) {
+        // Batagelj & Brandes: number the node pairs {w < v} as v(v-1)/2 + w (0-indexed), then instead of rolling a die
+        // for every pair, draw the geometric distributed number of pairs to skip until the next edge.
+        const std::uint64_t pairs = std::uint64_t(nodes) * (nodes - (nodes > 0)) / 2;
+        if (p <= 0 || pairs == 0) return {};
+        const double logQ = std::log1p(-p); // -inf for p >= 1, giving zero skips.
+        const auto maxWeight = defaultMaxWeight(nodes, weightLimit);
+        const std::size_t chunks = (pairs + skipChunkPairs - 1) / skipChunkPairs;
+
+        std::vector<EdgeList> chunkEdges(chunks);
+        parallelFor(chunks, [&](std::size_t chunk) {
+            const std::uint64_t begin = chunk * skipChunkPairs;
+            const std::uint64_t end = std::min(pairs, begin + skipChunkPairs);
+            // Each chunk has its own stream, derived from the seed and its index.
+            std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(chunk),
+                              static_cast<std::uint32_t>(chunk >> 32)};
+            std::mt19937_64 gen(seq);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            std::uniform_int_distribution<std::uint32_t> weight(1, maxWeight);
+            auto skip = [&]() -> std::uint64_t {
+                if (p >= 1) return 0;
+                double k = std::floor(std::log(1.0 - unit(gen)) / logQ);
+                return k >= static_cast<double>(end - begin) ? end - begin : static_cast<std::uint64_t>(k);
+            };
+
+            auto & out = chunkEdges[chunk];
+            out.reserve(static_cast<std::size_t>(p * static_cast<double>(end - begin) * 1.1) + 16);
+            std::uint64_t index = begin + skip();
+            if (index >= end) return;
+            // Recover (v, w) from the pair number once, afterwards just walk forward through the rows.
+            auto v = static_cast<std::uint64_t>((1.0 + std::sqrt(1.0 + 8.0 * static_cast<double>(index))) / 2.0);
+            while (v * (v - 1) / 2 > index) v--;
+            while ((v + 1) * v / 2 <= index) v++;
+            std::uint64_t w = index - v * (v - 1) / 2;
+            while (true) {
+                out.push_back({static_cast<std::uint32_t>(w + 1), static_cast<std::uint32_t>(v + 1), weight(gen)});
+                auto step = 1 + skip();
+                if (index + step >= end) break;
+                index += step;
+                w += step;
+                while (w >= v) {
+                    w -= v;
+                    v++;
                 }
-                if (iterSecond == output.end()){ // new
-                    std::vector<unsigned int> newComponent = std::vector<unsigned int>();
-                    newComponent.reserve(nodes+1);
-                    output.push_back(newComponent);
-                    output.back().push_back(line[0]);
-                    visited[line[0]] = true;
-                    iterSecond = --output.end();
-                } // add
-                (*iterSecond).push_back(line[1]);
-                visited[line[1]] = true;
             }
+        }, threads);
+
+        std::size_t total = 0;
+        for (const auto & part : chunkEdges) total += part.size();
+        EdgeList data;
+        data.reserve(total);
+        for (const auto & part : chunkEdges) data.insert(data.end(), part.begin(), part.end());
+        return data;
+    }
+
+    Graph erdosGraphConnected(unsigned int nodes, double p, int seed, unsigned int threads,
+                              std::uint32_t weightLimit) {
+        auto input = erdosInputGenSkip(nodes, p, seed, threads, weightLimit);
+        DisjointSet components(nodes + 1);
+        for (const auto & edge : input) {
+            components.unite(edge.u, edge.v);
         }
-        auto vectOut = std::vector<std::vector<unsigned int>>(output.begin(), output.end());
-        for (unsigned int i = 1; i <= nodes; i++){
-            if (!visited[i]){
-                vectOut.push_back({i});
-            }
+        if (nodes == 0 || components.getSetCount() == 2) return Graph(input, nodes); // node 0 is a set of its own
+
+        // Bridge the components in one pass: take them in random order and connect a random node of each to a random
+        // node of a random component placed before it. That grows a random tree over the components, so every bridge
+        // joins two different sets and we never need to look at the whole edge list again.
+        std::seed_seq seq{static_cast<std::uint32_t>(seed), 0x62726467u};
+        std::mt19937_64 gen(seq);
+        const auto maxWeight = defaultMaxWeight(nodes, weightLimit);
+        std::uniform_int_distribution<std::uint32_t> weight(1, maxWeight);
+        auto pick = [&gen](std::span<const unsigned int> component) {
+            return component[std::uniform_int_distribution<std::size_t>(0, component.size() - 1)(gen)];
+        };
+
+        auto concomp = components.getComponents(1);
+        std::vector<std::size_t> order(concomp.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), gen);
+        input.reserve(input.size() + order.size() - 1);
+        for (std::size_t k = 1; k < order.size(); k++) {
+            auto earlier = order[std::uniform_int_distribution<std::size_t>(0, k - 1)(gen)];
+            auto i = pick(concomp[order[k]]);
+            auto j = pick(concomp[earlier]);
+            components.unite(i, j);
+            input.push_back({std::min(i, j), std::max(i, j), weight(gen)});
+        }
+        return Graph(input, nodes);
+    }
+
+    Components findConnectedComponents(const EdgeList & input, unsigned int nodes) {
+        DisjointSet components(nodes + 1);
+        for (const auto & edge : input) {
+            components.unite(edge.u, edge.v);
         }
-        return vectOut;
+        return components.getComponents(1);
     }
 }
\ No newline at end of file
@@ -0,0 +1,233 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "../include/reduction.h"
+
+namespace graph_lib {
+    namespace {
+        // A branch of a pendant tree: its top node and the length of the longest path from its parent down into it.
+        struct Branch {
+            std::uint64_t length = 0;
+            unsigned int top = 0;   // 0 for no branch
+        };
+
+        struct BestBranches {
+            Branch first;
+            Branch second;
+
+            void offer(Branch branch) {
+                if (first.top == 0 || branch.length > first.length) {
+                    second = first;
+                    first = branch;
+                } else if (second.top == 0 || branch.length > second.length) {
+                    second = branch;
+                }
+            }
+        };
+
+        std::uint32_t edgeWeight(std::uint64_t length) {
+            if (length > static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max()))
+                throw std::runtime_error("Reduced edge weight " + std::to_string(length) + " does not fit an edge.");
+            return static_cast<std::uint32_t>(length);
+        }
+    }
+
+    PathSolution Reduction::expand(const PathSolution & reduced) const {
+        if (reduced.nodes.empty()) return internal;
+        PathSolution path{reduced.length, {}};
+        const auto & nodes = reduced.nodes;
+        // A leaf at an end stands for the branch below it, which is only walked if the path uses the leaf's edge.
+        if (nodes.size() > 1 && leaf[nodes.front()]) {
+            auto branch = hidden[nodes.front()];
+            path.nodes.insert(path.nodes.end(), branch.rbegin(), branch.rend());
+        }
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            const auto a = nodes[i];
+            path.nodes.push_back(original[a]);
+            if (i + 1 == nodes.size() || partner[a] != nodes[i + 1]) continue;
+            const auto b = nodes[i + 1];
+            if (a < b) {
+                auto interior = hidden[a];
+                path.nodes.insert(path.nodes.end(), interior.begin(), interior.end());
+            } else {
+                auto interior = hidden[b];
+                path.nodes.insert(path.nodes.end(), interior.rbegin(), interior.rend());
+            }
+        }
+        if (nodes.size() > 1 && leaf[nodes.back()]) {
+            auto branch = hidden[nodes.back()];
+            path.nodes.insert(path.nodes.end(), branch.begin(), branch.end());
+        }
+        return internal.length > path.length ? internal : path;
+    }
+
+    Reduction reduceGraph(const Graph & graph) {
+        const unsigned int n = graph.getNodeCount();
+        std::vector<unsigned int> degree(n + 1, 0), stack;
+        std::vector<bool> removed(n + 1, false);
+        std::vector<BestBranches> below(n + 1);
+        for (unsigned int v = 1; v <= n; v++) {
+            for (auto w : graph.getWeights(v)) {
+                if (w < 0) throw std::invalid_argument("Edge weights need to be non-negative.");
+            }
+            degree[v] = graph.getDegree(v);
+            if (degree[v] == 1) stack.push_back(v);
+        }
+
+        // Cut off leaves until none are left. Every cut off node hands its deepest branch (plus the edge up) to the
+        // one neighbour it still has, and is itself the top of the best path joining its two deepest branches.
+        std::uint64_t internalLength = 0;
+        unsigned int internalAt = 0;
+        while (!stack.empty()) {
+            const auto x = stack.back();
+            stack.pop_back();
+            if (degree[x] != 1) continue;   // The last node of a tree, it stays
+            removed[x] = true;
+            degree[x] = 0;
+            const auto through = below[x].first.length + below[x].second.length;
+            if (internalAt == 0 || through > internalLength) {
+                internalLength = through;
+                internalAt = x;
+            }
+            auto neighbours = graph.getNeighbours(x);
+            auto weights = graph.getWeights(x);
+            for (std::size_t k = 0; k < neighbours.size(); k++) {
+                const auto p = neighbours[k];
+                if (removed[p]) continue;
+                below[p].offer({below[x].first.length + weights[k], x});
+                if (--degree[p] == 1) stack.push_back(p);
+                break;
+            }
+        }
+        // The branch from top down, always following the deepest child.
+        auto descent = [&](unsigned int top) {
+            std::vector<unsigned int> nodes;
+            for (auto v = top; v != 0; v = below[v].first.top) nodes.push_back(v);
+            return nodes;
+        };
+
+        // Chains: maximal runs of remaining nodes with two remaining neighbours and no branches (a path may end in a
+        // branch, so those nodes have to stay). A path uses a chain in one of few ways: it runs through it, it lies
+        // inside it, or it ends in it coming from one or both sides. Ending at the far node of the chain is never
+        // worse, and when it enters from both sides it is best to leave out only the lightest edge. So a chain is
+        // replaced by its two ends and the lightest edge, joined by edges as heavy as the runs they replace.
+        auto inChain = [&](unsigned int v) {
+            return !removed[v] && degree[v] == 2 && below[v].first.top == 0;
+        };
+        // The remaining neighbour of chain node v other than previous.
+        auto step = [&](unsigned int v, unsigned int previous) {
+            for (auto u : graph.getNeighbours(v)) {
+                if (!removed[u] && u != previous) return u;
+            }
+            return 0u;
+        };
+        struct Chain {
+            unsigned int first, last;
+            std::uint64_t length;
+            std::vector<unsigned int> interior;
+        };
+        std::vector<Chain> chains;
+        std::vector<bool> chained(n + 1, false), dropped(n + 1, false);
+        std::vector<unsigned int> left, right;
+        for (unsigned int v = 1; v <= n; v++) {
+            if (chained[v] || !inChain(v)) continue;
+            chained[v] = true;
+            // Walk both ways from v until the chain ends, or comes back to v when the component is a cycle.
+            bool cycle = false;
+            auto walk = [&](unsigned int previous, unsigned int current, std::vector<unsigned int> & out) {
+                out.clear();
+                while (inChain(current)) {
+                    if (current == v) {
+                        cycle = true;
+                        return;
+                    }
+                    chained[current] = true;
+                    out.push_back(current);
+                    auto next = step(current, previous);
+                    previous = current;
+                    current = next;
+                }
+            };
+            const auto first = step(v, 0);
+            walk(v, first, right);
+            if (cycle) continue;
+            walk(v, step(v, first), left);
+            std::vector<unsigned int> nodes(left.rbegin(), left.rend());
+            nodes.push_back(v);
+            nodes.insert(nodes.end(), right.begin(), right.end());
+            if (nodes.size() < 5) continue;
+
+            // Keep the ends and the lightest edge, and replace the runs in between by single edges.
+            std::size_t lightest = 0;
+            for (std::size_t i = 1; i + 1 < nodes.size(); i++) {
+                if (graph.getEdge(nodes[i], nodes[i + 1]) < graph.getEdge(nodes[lightest], nodes[lightest + 1]))
+                    lightest = i;
+            }
+            for (auto [from, to] : {std::pair(std::size_t(0), lightest), std::pair(lightest + 1, nodes.size() - 1)}) {
+                if (to - from < 2) continue;
+                Chain chain{nodes[from], nodes[to], 0, {nodes.begin() + from + 1, nodes.begin() + to}};
+                for (auto i = from; i < to; i++) chain.length += graph.getEdge(nodes[i], nodes[i + 1]);
+                for (auto x : chain.interior) dropped[x] = true;
+                chains.push_back(std::move(chain));
+            }
+        }
+
+        // Number the remaining nodes in their original order, then the new leaves.
+        std::vector<unsigned int> id(n + 1, 0), original{0};
+        for (unsigned int v = 1; v <= n; v++) {
+            if (removed[v] || dropped[v]) continue;
+            id[v] = original.size();
+            original.push_back(v);
+        }
+        const auto kept = static_cast<unsigned int>(original.size());
+        EdgeList edges;
+        std::vector<std::vector<unsigned int>> hidden(kept);
+        for (unsigned int i = 1; i < kept; i++) {
+            const auto v = original[i];
+            auto neighbours = graph.getNeighbours(v);
+            auto weights = graph.getWeights(v);
+            for (std::size_t k = 0; k < neighbours.size(); k++) {
+                if (neighbours[k] > v && id[neighbours[k]] != 0)
+                    edges.push_back({id[v], id[neighbours[k]], static_cast<std::uint32_t>(weights[k])});
+            }
+            for (auto branch : {below[v].first, below[v].second}) {
+                if (branch.top == 0) continue;
+                const auto leaf = static_cast<unsigned int>(original.size());
+                original.push_back(branch.top);
+                auto nodes = descent(branch.top);
+                hidden.emplace_back(nodes.begin() + 1, nodes.end());
+                edges.push_back({id[v], leaf, edgeWeight(branch.length)});
+            }
+        }
+        const auto count = static_cast<unsigned int>(original.size() - 1);
+        std::vector<unsigned int> partner(count + 1, 0);
+        for (auto & chain : chains) {
+            auto a = id[chain.first], b = id[chain.last];
+            edges.push_back({a, b, edgeWeight(chain.length)});
+            partner[a] = b;
+            partner[b] = a;
+            hidden[std::min(a, b)] = a < b ? chain.interior
+                                            : std::vector<unsigned int>(chain.interior.rbegin(), chain.interior.rend());
+        }
+        Reduction reduction{Graph(edges, count), std::move(original), std::move(partner), {}, {}, {}};
+        reduction.hidden.offsets.push_back(0);
+        for (auto & nodes : hidden) {
+            reduction.hidden.nodes.insert(reduction.hidden.nodes.end(), nodes.begin(), nodes.end());
+            reduction.hidden.offsets.push_back(reduction.hidden.nodes.size());
+        }
+        reduction.leaf.assign(count + 1, false);
+        for (auto i = kept; i <= count; i++) reduction.leaf[i] = true;
+
+        if (internalAt != 0) {
+            auto first = descent(below[internalAt].first.top);
+            auto second = descent(below[internalAt].second.top);
+            reduction.internal = {internalLength, {first.rbegin(), first.rend()}};
+            reduction.internal.nodes.push_back(internalAt);
+            reduction.internal.nodes.insert(reduction.internal.nodes.end(), second.begin(), second.end());
+        }
+        return reduction;
+    }
+}
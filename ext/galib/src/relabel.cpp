@@ -0,0 +1,115 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "../include/relabel.h"
+
+namespace graph_lib {
+    namespace {
+        // Breadth first order of all nodes, every component starting from its lowest degree node. With byDegree the
+        // neighbours of a node are queued in order of increasing degree (Cuthill-McKee).
+        std::vector<unsigned int> breadthFirst(const Graph & graph, bool byDegree) {
+            const unsigned int n = graph.getNodeCount();
+            std::vector<unsigned int> starts(n);
+            std::iota(starts.begin(), starts.end(), 1);
+            std::stable_sort(starts.begin(), starts.end(), [&](unsigned int a, unsigned int b) {
+                return graph.getDegree(a) < graph.getDegree(b);
+            });
+
+            std::vector<unsigned int> order{0};
+            std::vector<bool> queued(n + 1, false);
+            std::vector<unsigned int> children;
+            order.reserve(n + 1);
+            for (auto start : starts) {
+                if (queued[start]) continue;
+                queued[start] = true;
+                order.push_back(start);
+                for (auto i = order.size() - 1; i < order.size(); i++) {
+                    children.clear();
+                    for (auto u : graph.getNeighbours(order[i])) {
+                        if (!queued[u]) {
+                            queued[u] = true;
+                            children.push_back(u);
+                        }
+                    }
+                    if (byDegree) {
+                        std::stable_sort(children.begin(), children.end(), [&](unsigned int a, unsigned int b) {
+                            return graph.getDegree(a) < graph.getDegree(b);
+                        });
+                    }
+                    order.insert(order.end(), children.begin(), children.end());
+                }
+            }
+            return order;
+        }
+    }
+
+    NodeOrder parseNodeOrder(const std::string & name) {
+        if (name == "none" || name.empty()) return NodeOrder::Original;
+        if (name == "bfs") return NodeOrder::Bfs;
+        if (name == "rcm") return NodeOrder::ReverseCuthillMcKee;
+        if (name == "degree") return NodeOrder::Degree;
+        throw std::invalid_argument("Unknown node order '" + name + "', expected none, bfs, rcm or degree.");
+    }
+
+    PathSolution Relabeling::restore(const PathSolution & path) const {
+        PathSolution original{path.length, path.nodes};
+        for (auto & v : original.nodes) v = toOriginal[v];
+        return original;
+    }
+
+    std::vector<unsigned int> Relabeling::restoreGenes(const std::vector<unsigned int> & genes) const {
+        std::vector<unsigned int> original(genes.size());
+        original[0] = toOriginal[genes[0]];
+        for (std::size_t v = 1; v < genes.size(); v++) original[toOriginal[v]] = toOriginal[genes[v]];
+        return original;
+    }
+
+    std::vector<unsigned int> Relabeling::relabelGenes(const std::vector<unsigned int> & genes) const {
+        std::vector<unsigned int> relabeled(genes.size());
+        relabeled[0] = toNew[genes[0]];
+        for (std::size_t v = 1; v < genes.size(); v++) relabeled[toNew[v]] = toNew[genes[v]];
+        return relabeled;
+    }
+
+    Relabeling relabelGraph(const Graph & graph, NodeOrder order) {
+        const unsigned int n = graph.getNodeCount();
+        std::vector<unsigned int> toOriginal;
+        switch (order) {
+            case NodeOrder::Original:
+                toOriginal.resize(n + 1);
+                std::iota(toOriginal.begin(), toOriginal.end(), 0);
+                break;
+            case NodeOrder::Bfs:
+                toOriginal = breadthFirst(graph, false);
+                break;
+            case NodeOrder::ReverseCuthillMcKee:
+                toOriginal = breadthFirst(graph, true);
+                std::reverse(toOriginal.begin() + 1, toOriginal.end());
+                break;
+            case NodeOrder::Degree:
+                toOriginal.resize(n + 1);
+                std::iota(toOriginal.begin(), toOriginal.end(), 0);
+                std::stable_sort(toOriginal.begin() + 1, toOriginal.end(), [&](unsigned int a, unsigned int b) {
+                    return graph.getDegree(a) > graph.getDegree(b);
+                });
+                break;
+        }
+        std::vector<unsigned int> toNew(n + 1, 0);
+        for (unsigned int v = 1; v <= n; v++) toNew[toOriginal[v]] = v;
+
+        EdgeList edges;
+        edges.reserve(graph.getEntryCount() / 2);
+        for (unsigned int v = 1; v <= n; v++) {
+            auto neighbours = graph.getNeighbours(v);
+            auto weights = graph.getWeights(v);
+            for (std::size_t k = 0; k < neighbours.size(); k++) {
+                if (neighbours[k] > v)
+                    edges.push_back({toNew[v], toNew[neighbours[k]], static_cast<std::uint32_t>(weights[k])});
+            }
+        }
+        return {Graph(edges, n), std::move(toOriginal), std::move(toNew)};
+    }
+}
@@ -0,0 +1,121 @@
+//
+// Created on 18/10/2026.
+//
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+#include "../include/resultCache.h"
+
+namespace graph_lib {
+    namespace {
+        constexpr char entryMagic[8] = {'G', 'L', 'R', 'E', 'S', 0, 0, 0};
+
+        struct EntryHeader {
+            char magic[8];                  // "GLRES" padded with zeroes
+            std::uint32_t version;          // resultCacheVersion at time of writing
+            std::uint32_t algorithmVersion;
+            std::uint64_t key;              // Guards against a file renamed to another key
+            std::uint64_t count;            // Nr of doubles after the header
+        };
+
+        // Reads the header of an entry, false if the file is too short or not an entry.
+        bool readHeader(std::ifstream & in, EntryHeader & header) {
+            in.read(reinterpret_cast<char *>(&header), sizeof(header));
+            return in && std::memcmp(header.magic, entryMagic, sizeof(entryMagic)) == 0;
+        }
+
+        // Whether a file of fileSize bytes holds exactly the header and its count doubles. Checked before allocating
+        // anything, a corrupt count must not turn into a huge allocation.
+        bool countMatches(const EntryHeader & header, std::uintmax_t fileSize) {
+            if (fileSize < sizeof(header)) return false;
+            const auto payload = fileSize - sizeof(header);
+            return payload % sizeof(double) == 0 && header.count == payload / sizeof(double);
+        }
+    }
+
+    KeyHasher & KeyHasher::add(const void * data, std::size_t length) {
+        auto bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < length; i++) {
+            hash_ = (hash_ ^ bytes[i]) * 0x100000001b3ULL;
+        }
+        return *this;
+    }
+
+    KeyHasher & KeyHasher::add(std::string_view text) {
+        add(text.size());
+        return add(text.data(), text.size());
+    }
+
+    ResultCache::ResultCache(std::string directory, std::uint32_t algorithmVersion)
+        : directory_(std::move(directory)), algorithmVersion_(algorithmVersion) {}
+
+    std::string ResultCache::path(std::uint64_t key) const {
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(directory_) / std::string(name, 2) / (std::string(name + 2) + ".res")).string();
+    }
+
+    std::optional<std::vector<double>> ResultCache::load(std::uint64_t key) const {
+        if (!enabled()) return std::nullopt;
+        const auto filename = path(key);
+        std::ifstream in(filename, std::ios::binary);
+        EntryHeader header{};
+        std::error_code error;
+        if (!in || !readHeader(in, header) || header.version != resultCacheVersion
+            || header.algorithmVersion != algorithmVersion_ || header.key != key
+            || !countMatches(header, std::filesystem::file_size(filename, error)) || error)
+            return std::nullopt;
+        std::vector<double> values(header.count);
+        in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+        if (!in) return std::nullopt;  // Truncated, e.g. by a full disk
+        return values;
+    }
+
+    void ResultCache::store(std::uint64_t key, const std::vector<double> & values) const {
+        if (!enabled()) return;
+        static std::atomic<std::uint64_t> stores = 0;
+        auto filename = path(key);
+        std::filesystem::create_directories(std::filesystem::path(filename).parent_path());
+
+        EntryHeader header{};
+        std::memcpy(header.magic, entryMagic, sizeof(entryMagic));
+        header.version = resultCacheVersion;
+        header.algorithmVersion = algorithmVersion_;
+        header.key = key;
+        header.count = values.size();
+
+        // Write next to the destination and rename afterwards, rename is atomic within a filesystem.
+        auto temporary = filename + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(stores++);
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("Could not open " + temporary + " for writing.");
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(values.data()),
+                      static_cast<std::streamsize>(values.size() * sizeof(double)));
+            if (!out) throw std::runtime_error("Could not write result " + temporary + ".");
+        }
+        std::filesystem::rename(temporary, filename);
+    }
+
+    std::size_t ResultCache::prune() const {
+        if (!enabled() || !std::filesystem::exists(directory_)) return 0;
+        std::size_t removed = 0;
+        for (auto & entry : std::filesystem::recursive_directory_iterator(directory_)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".res") continue;
+            EntryHeader header{};
+            bool keep;
+            {
+                std::ifstream in(entry.path(), std::ios::binary);
+                keep = readHeader(in, header) && header.version == resultCacheVersion
+                       && header.algorithmVersion == algorithmVersion_
+                       && countMatches(header, entry.file_size());
+            }
+            if (!keep && std::filesystem::remove(entry.path())) removed++;
+        }
+        return removed;
+    }
+}
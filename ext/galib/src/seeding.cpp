@@ -0,0 +1,210 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include "../include/parallel.h"
+#include "../include/seeding.h"
+
+namespace graph_lib {
+    namespace {
+        // A greedy step may take any unvisited edge at least this close (as a fraction of the spread) to the heaviest.
+        constexpr double greedyTolerance = 0.25;
+        // Depth first searches per RandomDfs seed, and nodes sampled to find a low degree start.
+        constexpr int dfsRestarts = 2;
+        constexpr int startSamples = 8;
+
+        // The lowest degree node out of a few random ones, preferring nodes that have any edge at all.
+        template <typename G>
+        unsigned int lowDegreeStart(const G & graph, std::mt19937 & gen) {
+            std::uniform_int_distribution<unsigned int> node(1, graph.getNodeCount());
+            unsigned int best = node(gen);
+            for (int i = 1; i < startSamples; i++) {
+                auto v = node(gen);
+                auto degree = graph.getDegree(v), bestDegree = graph.getDegree(best);
+                if (bestDegree == 0 || (degree > 0 && degree < bestDegree)) best = v;
+            }
+            return best;
+        }
+
+        // Walks from start over unvisited nodes, marking them, and returns the nodes after start.
+        template <typename G>
+        std::vector<unsigned int> greedyWalk(const G & graph, unsigned int start, std::vector<bool> & visited,
+                                             std::mt19937 & gen) {
+            std::vector<unsigned int> walk, candidates;
+            for (auto current = start;;) {
+                auto neighbours = graph.getNeighbours(current);
+                auto weights = graph.getWeights(current);
+                double lightest = 0, heaviest = 0;
+                bool any = false;
+                for (std::size_t k = 0; k < neighbours.size(); k++) {
+                    if (visited[neighbours[k]]) continue;
+                    auto w = static_cast<double>(weights[k]);
+                    lightest = any ? std::min(lightest, w) : w;
+                    heaviest = any ? std::max(heaviest, w) : w;
+                    any = true;
+                }
+                if (!any) break;
+                candidates.clear();
+                const double threshold = heaviest - (heaviest - lightest) * greedyTolerance;
+                for (std::size_t k = 0; k < neighbours.size(); k++) {
+                    if (!visited[neighbours[k]] && static_cast<double>(weights[k]) >= threshold)
+                        candidates.push_back(neighbours[k]);
+                }
+                current = candidates[gen() % candidates.size()];
+                visited[current] = true;
+                walk.push_back(current);
+            }
+            return walk;
+        }
+
+        template <typename G>
+        std::vector<unsigned int> greedyPath(const G & graph, std::mt19937 & gen) {
+            std::vector<bool> visited(graph.getNodeCount() + 1, false);
+            const auto start = std::uniform_int_distribution<unsigned int>(1, graph.getNodeCount())(gen);
+            visited[start] = true;
+            auto forward = greedyWalk(graph, start, visited, gen);
+            auto backward = greedyWalk(graph, start, visited, gen);
+            std::vector<unsigned int> path(backward.rbegin(), backward.rend());
+            path.push_back(start);
+            path.insert(path.end(), forward.begin(), forward.end());
+            return path;
+        }
+
+        // Every node of the search tree has its neighbours tried starting from a random one, which shuffles the search
+        // without a permutation per node. The deepest path on the stack is copied out when the search backs up from it.
+        template <typename G>
+        std::vector<unsigned int> dfsPath(const G & graph, std::mt19937 & gen) {
+            using Length = typename G::Length;
+            struct Frame {
+                unsigned int node;
+                std::size_t offset, tried;
+                Length length;
+            };
+            std::vector<unsigned int> best;
+            Length bestLength = 0;
+            std::vector<bool> visited;
+            std::vector<Frame> stack;
+            for (int restart = 0; restart < dfsRestarts; restart++) {
+                visited.assign(graph.getNodeCount() + 1, false);
+                auto push = [&](unsigned int v, Length length) {
+                    visited[v] = true;
+                    auto degree = graph.getDegree(v);
+                    stack.push_back({v, degree > 0 ? gen() % degree : 0, 0, length});
+                };
+                const auto start = lowDegreeStart(graph, gen);
+                push(start, 0);
+                bool deeper = best.empty();
+                while (!stack.empty()) {
+                    auto & frame = stack.back();
+                    auto neighbours = graph.getNeighbours(frame.node);
+                    if (frame.tried == neighbours.size()) {
+                        if (deeper) {
+                            best.clear();
+                            for (auto & f : stack) best.push_back(f.node);
+                            deeper = false;
+                        }
+                        stack.pop_back();
+                        continue;
+                    }
+                    auto k = (frame.offset + frame.tried++) % neighbours.size();
+                    if (visited[neighbours[k]]) continue;
+                    auto length = frame.length + static_cast<Length>(graph.getWeights(frame.node)[k]);
+                    push(neighbours[k], length);
+                    if (length > bestLength) {
+                        bestLength = length;
+                        deeper = true;
+                    }
+                }
+            }
+            return best;
+        }
+
+        template <typename G>
+        std::vector<unsigned int> warnsdorffPath(const G & graph, std::mt19937 & gen) {
+            std::vector<bool> visited(graph.getNodeCount() + 1, false);
+            auto current = lowDegreeStart(graph, gen);
+            std::vector<unsigned int> path{current};
+            visited[current] = true;
+            while (true) {
+                // The fewest onward moves wins, but a dead end only when there is nothing else. Ties are broken
+                // uniformly by reservoir sampling.
+                unsigned int next = 0, nextRank = 0, ties = 0;
+                for (auto u : graph.getNeighbours(current)) {
+                    if (visited[u]) continue;
+                    unsigned int onward = 0;
+                    for (auto x : graph.getNeighbours(u)) onward += !visited[x];
+                    const auto rank = onward == 0 ? graph.getNodeCount() + 1 : onward;
+                    if (next == 0 || rank < nextRank) {
+                        next = u;
+                        nextRank = rank;
+                        ties = 1;
+                    } else if (rank == nextRank && gen() % ++ties == 0) {
+                        next = u;
+                    }
+                }
+                if (next == 0) break;
+                visited[next] = true;
+                path.push_back(next);
+                current = next;
+            }
+            return path;
+        }
+    }
+
+    template <typename G>
+    std::vector<unsigned int> seedPath(const G & graph, SeedHeuristic heuristic, std::mt19937 & gen) {
+        if (graph.getNodeCount() == 0) return {};
+        switch (heuristic) {
+            case SeedHeuristic::GreedyWalk: return greedyPath(graph, gen);
+            case SeedHeuristic::RandomDfs: return dfsPath(graph, gen);
+            case SeedHeuristic::Warnsdorff: return warnsdorffPath(graph, gen);
+        }
+        return {};
+    }
+
+    template <typename G>
+    std::vector<unsigned int> encodePath(const G & graph, const std::vector<unsigned int> & path, std::mt19937 & gen) {
+        std::vector<unsigned int> genes(graph.getNodeCount() + 1, 0);
+        for (unsigned int v = 1; v <= graph.getNodeCount(); v++) genes[v] = graph.getRandomEdge(v, gen);
+        if (path.empty()) return genes;
+        genes[0] = path[0];
+        for (std::size_t i = 0; i + 1 < path.size(); i++) genes[path[i]] = path[i + 1];
+        return genes;
+    }
+
+    template <typename G>
+    std::vector<std::vector<unsigned int>> seedChromosomes(const G & graph, std::size_t count, std::uint64_t seed,
+                                                           unsigned int threads) {
+        constexpr SeedHeuristic heuristics[] = {SeedHeuristic::GreedyWalk, SeedHeuristic::RandomDfs,
+                                                SeedHeuristic::Warnsdorff};
+        std::vector<std::vector<unsigned int>> chromosomes(count);
+        parallelFor(count, [&](std::size_t i) {
+            // Each seed has its own stream, derived from the seed and its index.
+            std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                              static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32)};
+            std::mt19937 gen(seq);
+            chromosomes[i] = encodePath(graph, seedPath(graph, heuristics[i % std::size(heuristics)], gen), gen);
+        }, threads);
+        return chromosomes;
+    }
+
+    template std::vector<unsigned int> seedPath(const Graph &, SeedHeuristic, std::mt19937 &);
+    template std::vector<unsigned int> seedPath(const CompactGraph &, SeedHeuristic, std::mt19937 &);
+    template std::vector<unsigned int> seedPath(const FloatGraph &, SeedHeuristic, std::mt19937 &);
+    template std::vector<unsigned int> seedPath(const RealGraph &, SeedHeuristic, std::mt19937 &);
+    template std::vector<unsigned int> encodePath(const Graph &, const std::vector<unsigned int> &, std::mt19937 &);
+    template std::vector<unsigned int> encodePath(const CompactGraph &, const std::vector<unsigned int> &,
+                                                  std::mt19937 &);
+    template std::vector<unsigned int> encodePath(const FloatGraph &, const std::vector<unsigned int> &,
+                                                  std::mt19937 &);
+    template std::vector<unsigned int> encodePath(const RealGraph &, const std::vector<unsigned int> &,
+                                                  std::mt19937 &);
+    template std::vector<std::vector<unsigned int>> seedChromosomes(const Graph &, std::size_t, std::uint64_t,
+                                                                    unsigned int);
+    template std::vector<std::vector<unsigned int>> seedChromosomes(const CompactGraph &, std::size_t, std::uint64_t,
+                                                                    unsigned int);
+    template std::vector<std::vector<unsigned int>> seedChromosomes(const FloatGraph &, std::size_t, std::uint64_t,
+                                                                    unsigned int);
+    template std::vector<std::vector<unsigned int>> seedChromosomes(const RealGraph &, std::size_t, std::uint64_t,
+                                                                    unsigned int);
+}
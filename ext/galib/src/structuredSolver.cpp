@@ -0,0 +1,540 @@
+//
+// Created on 18/10/2026.
+//
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include "../include/structuredSolver.h"
+#include "../include/blocks.h"
+#include "../include/parallel.h"
+
+namespace graph_lib {
+    namespace {
+        constexpr std::size_t noBlock = static_cast<std::size_t>(-1);
+
+        std::uint64_t edgeCount(const Graph & graph) {
+            return graph.getEntryCount() / 2;
+        }
+
+        unsigned int componentCount(const Graph & graph) {
+            DisjointSet components(graph.getNodeCount() + 1);
+            for (unsigned int v = 1; v <= graph.getNodeCount(); v++) {
+                for (auto u : graph.getNeighbours(v)) components.unite(v, u);
+            }
+            return components.getSetCount() - 1; // node 0
+        }
+
+        PathSolution reversed(PathSolution path) {
+            std::reverse(path.nodes.begin(), path.nodes.end());
+            return path;
+        }
+
+        // Appends tail to path, where tail starts at the node path ends in.
+        void extend(PathSolution & path, const PathSolution & tail) {
+            path.length += tail.length;
+            path.nodes.insert(path.nodes.end(), tail.nodes.begin() + 1, tail.nodes.end());
+        }
+
+        bool isCycle(std::size_t nodes, std::size_t edges) {
+            // A biconnected block with as many edges as nodes is a single cycle.
+            return nodes >= 3 && edges == nodes;
+        }
+
+        std::uint64_t totalWeight(std::span<const Edge> edges) {
+            std::uint64_t total = 0;
+            for (auto & edge : edges) total += edge.w;
+            return total;
+        }
+
+        // Large blocks run a subset DP from each of their articulation points and one for the path inside them, the
+        // work of all of them together has to stay within blockDpBudget. longestPathDp keeps lengths in 32 bits.
+        bool isSolvable(const Blocks & blocks) {
+            std::uint64_t work = 0;
+            for (std::size_t b = 0; b < blocks.blocks.size(); b++) {
+                auto nodes = blocks.blocks[b];
+                if (isCycle(nodes.size(), blocks.getEdges(b).size()) || nodes.size() <= blockTableMaxNodes) continue;
+                if (nodes.size() > blockDpMaxNodes
+                    || totalWeight(blocks.getEdges(b)) >= std::numeric_limits<std::uint32_t>::max())
+                    return false;
+                auto cuts = std::count_if(nodes.begin(), nodes.end(), [&](auto v) { return blocks.isArticulation(v); });
+                work += (cuts + 1) * (std::uint64_t(1) << nodes.size()) * nodes.size() * nodes.size();
+            }
+            return work <= blockDpBudget;
+        }
+
+        // The ends s != t maximising extra(s) + between(s, t) + extra(t).
+        struct PairChoice {
+            std::uint64_t length = 0;
+            unsigned int s = 0;
+            unsigned int t = 0;
+        };
+
+        // Longest paths inside one block between any two of its nodes (given by node id). In a cycle every pair is
+        // joined by exactly two arcs, so prefix sums along the cycle answer everything. Small blocks keep a table of
+        // all pairs filled by a subset DP from every start node. Larger ones only fill the rows of their articulation
+        // points, cuts, since paths only enter and leave a block through those, and solve the best path inside them
+        // with longestPathDp.
+        class BlockPaths {
+        public:
+            BlockPaths() = default;
+
+            BlockPaths(std::span<const unsigned int> nodes, std::span<const Edge> edges,
+                       std::span<const unsigned int> cuts)
+                : nodes(nodes), k(nodes.size()), cycle(isCycle(nodes.size(), edges.size())),
+                  large(!cycle && nodes.size() > blockTableMaxNodes) {
+                if (cycle) {
+                    solveCycle(edges);
+                    return;
+                }
+                weight.assign(k * k, -1);
+                for (auto & edge : edges) {
+                    weight[local(edge.u) * k + local(edge.v)] = edge.w;
+                    weight[local(edge.v) * k + local(edge.u)] = edge.w;
+                }
+                lengths.assign(k * k, 0);
+                std::vector<std::int64_t> dp;
+                // One DP from start i gives the longest paths from i to every other node.
+                auto fillRow = [&](unsigned int i) {
+                    runDp(i, dp);
+                    for (std::size_t mask = 0; mask < (std::size_t(1) << k); mask++) {
+                        for (unsigned int v = 0; v < k; v++) {
+                            auto value = dp[mask * k + v];
+                            if (value > 0) lengths[i * k + v] = std::max<std::uint64_t>(lengths[i * k + v], value);
+                        }
+                    }
+                };
+                if (large) {
+                    for (auto cut : cuts) fillRow(local(cut));
+                    inside = solveInside(edges);
+                } else {
+                    for (unsigned int i = 0; i < k; i++) fillRow(i);
+                }
+            }
+
+            // For large blocks s has to be an articulation point, in between and from as well as in path.
+            std::uint64_t between(unsigned int s, unsigned int t) const {
+                if (!cycle) return lengths[local(s) * k + local(t)];
+                auto d = forward(position[local(s)], position[local(t)]);
+                return s == t ? 0 : std::max(d, circumference() - d);
+            }
+
+            std::uint64_t from(unsigned int s) const {
+                if (cycle) {
+                    auto p = position[local(s)];
+                    return circumference() - std::min(edgeWeight((p + k - 1) % k), edgeWeight(p));
+                }
+                auto row = lengths.begin() + local(s) * k;
+                return *std::max_element(row, row + k);
+            }
+
+            std::uint64_t full() const {
+                if (large) return inside.length;
+                if (cycle) return circumference() - lightestEdge().second;
+                return *std::max_element(lengths.begin(), lengths.end());
+            }
+
+            PairChoice bestPair(const std::vector<std::pair<unsigned int, std::uint64_t>> & ends) const {
+                PairChoice best;
+                if (ends.size() < 2) return best;
+                if (!cycle) {
+                    for (std::size_t i = 0; i < ends.size(); i++) {
+                        for (std::size_t j = i + 1; j < ends.size(); j++) {
+                            auto length = ends[i].second + between(ends[i].first, ends[j].first) + ends[j].second;
+                            if (length > best.length) best = {length, ends[i].first, ends[j].first};
+                        }
+                    }
+                    return best;
+                }
+                // Sorted along the cycle, the arc from i to a later j is prefix[j] - prefix[i] and the other one
+                // circumference() minus that, so keeping the best extra - prefix and extra + prefix of the ends seen
+                // so far gives the best partner of every j in O(1).
+                std::vector<std::pair<std::uint32_t, std::uint64_t>> sorted;    // (position, extra)
+                std::vector<unsigned int> node(k);
+                for (auto [v, extra] : ends) {
+                    sorted.emplace_back(position[local(v)], extra);
+                    node[position[local(v)]] = v;
+                }
+                std::sort(sorted.begin(), sorted.end());
+                std::int64_t bestMinus = 0, bestPlus = 0;
+                unsigned int minusAt = 0, plusAt = 0;
+                for (std::size_t j = 0; j < sorted.size(); j++) {
+                    auto [p, extra] = sorted[j];
+                    auto offset = static_cast<std::int64_t>(prefix[p]);
+                    if (j > 0) {
+                        auto one = static_cast<std::uint64_t>(static_cast<std::int64_t>(extra) + offset + bestMinus);
+                        auto other = static_cast<std::uint64_t>(static_cast<std::int64_t>(extra) - offset + bestPlus)
+                                     + circumference();
+                        if (one > best.length) best = {one, node[minusAt], node[p]};
+                        if (other > best.length) best = {other, node[plusAt], node[p]};
+                    }
+                    auto minus = static_cast<std::int64_t>(extra) - offset;
+                    auto plus = static_cast<std::int64_t>(extra) + offset;
+                    if (j == 0 || minus > bestMinus) bestMinus = minus, minusAt = p;
+                    if (j == 0 || plus > bestPlus) bestPlus = plus, plusAt = p;
+                }
+                return best;
+            }
+
+            // A path of length between(s, t) from s to t, from(s) if t is 0, full() if s is 0 as well.
+            PathSolution path(unsigned int s = 0, unsigned int t = 0) const {
+                if (large && s == 0) return inside;
+                return cycle ? cyclePath(s, t) : tablePath(s, t);
+            }
+
+        private:
+            unsigned int local(unsigned int v) const {
+                return std::lower_bound(nodes.begin(), nodes.end(), v) - nodes.begin();
+            }
+
+            void solveCycle(std::span<const Edge> edges) {
+                // Both cycle neighbours of every node, with the weights of the edges to them.
+                std::vector<std::array<std::pair<unsigned int, std::uint32_t>, 2>> next(k);
+                std::vector<unsigned int> seen(k, 0);
+                for (auto & edge : edges) {
+                    auto u = local(edge.u), v = local(edge.v);
+                    next[u][seen[u]++] = {v, edge.w};
+                    next[v][seen[v]++] = {u, edge.w};
+                }
+                order.reserve(k);
+                position.resize(k);
+                prefix.assign(1, 0);
+                unsigned int previous = k, current = 0;
+                while (order.size() < k) {
+                    position[current] = order.size();
+                    order.push_back(current);
+                    auto step = next[current][0].first == previous ? next[current][1] : next[current][0];
+                    prefix.push_back(prefix.back() + step.second);
+                    previous = current;
+                    current = step.first;
+                }
+            }
+
+            // The longest path anywhere inside the block, by longestPathDp on the block alone.
+            PathSolution solveInside(std::span<const Edge> edges) const {
+                EdgeList blockEdges;
+                blockEdges.reserve(edges.size());
+                for (auto & edge : edges) blockEdges.push_back({local(edge.u) + 1, local(edge.v) + 1, edge.w});
+                // Blocks are already solved in parallel.
+                auto best = longestPathDp(Graph(blockEdges, k), 1);
+                PathSolution path{best.length, {}};
+                for (auto v : best.nodes) path.nodes.push_back(nodes[v - 1]);
+                return path;
+            }
+
+            std::uint64_t circumference() const { return prefix[k]; }
+            std::uint64_t edgeWeight(std::size_t p) const { return prefix[p + 1] - prefix[p]; }
+            // Length of the arc going forward from position p to position q.
+            std::uint64_t forward(std::size_t p, std::size_t q) const {
+                return q >= p ? prefix[q] - prefix[p] : circumference() - (prefix[p] - prefix[q]);
+            }
+            std::pair<std::size_t, std::uint64_t> lightestEdge() const {
+                std::pair<std::size_t, std::uint64_t> lightest{0, edgeWeight(0)};
+                for (std::size_t p = 1; p < k; p++) {
+                    if (edgeWeight(p) < lightest.second) lightest = {p, edgeWeight(p)};
+                }
+                return lightest;
+            }
+
+            // Walks steps edges along the cycle from position p, forwards or backwards.
+            PathSolution walk(std::size_t p, bool forwards, std::size_t steps) const {
+                PathSolution path{0, {nodes[order[p]]}};
+                for (std::size_t i = 0; i < steps; i++) {
+                    auto edge = forwards ? p : (p + k - 1) % k;
+                    path.length += edgeWeight(edge);
+                    p = forwards ? (p + 1) % k : (p + k - 1) % k;
+                    path.nodes.push_back(nodes[order[p]]);
+                }
+                return path;
+            }
+
+            PathSolution cyclePath(unsigned int s, unsigned int t) const {
+                if (s == 0) return walk((lightestEdge().first + 1) % k, true, k - 1);
+                auto p = position[local(s)];
+                if (t == 0) return walk(p, edgeWeight((p + k - 1) % k) <= edgeWeight(p), k - 1);
+                auto q = position[local(t)];
+                auto d = forward(p, q);
+                return d >= circumference() - d ? walk(p, true, (q + k - p) % k) : walk(p, false, (p + k - q) % k);
+            }
+
+            // dp[mask * k + v]: longest path from local node i through exactly the nodes of mask to v, -1 for none.
+            void runDp(unsigned int i, std::vector<std::int64_t> & dp) const {
+                dp.assign((std::size_t(1) << k) * k, -1);
+                dp[(std::size_t(1) << i) * k + i] = 0;
+                for (std::size_t mask = 0; mask < (std::size_t(1) << k); mask++) {
+                    if (!(mask >> i & 1)) continue;
+                    for (unsigned int v = 0; v < k; v++) {
+                        auto value = dp[mask * k + v];
+                        if (value < 0) continue;
+                        for (unsigned int u = 0; u < k; u++) {
+                            auto w = weight[v * k + u];
+                            if (w < 0 || mask >> u & 1) continue;
+                            auto & next = dp[(mask | std::size_t(1) << u) * k + u];
+                            next = std::max(next, value + w);
+                        }
+                    }
+                }
+            }
+
+            PathSolution tablePath(unsigned int s, unsigned int t) const {
+                unsigned int i, j;
+                if (s == 0) {
+                    auto best = std::max_element(lengths.begin(), lengths.end()) - lengths.begin();
+                    i = best / k;
+                    j = best % k;
+                } else {
+                    i = local(s);
+                    auto row = lengths.begin() + i * k;
+                    j = t == 0 ? static_cast<unsigned int>(std::max_element(row, row + k) - row) : local(t);
+                }
+                PathSolution path{lengths[i * k + j], {}};
+                std::vector<std::int64_t> dp;
+                runDp(i, dp);
+                std::size_t mask = 0;
+                while (dp[mask * k + j] != static_cast<std::int64_t>(path.length)) mask++;
+                // Walk back from j: the node before it is one whose entry plus the edge gives ours.
+                while (true) {
+                    path.nodes.push_back(nodes[j]);
+                    if (j == i) break;
+                    auto value = dp[mask * k + j];
+                    mask &= ~(std::size_t(1) << j);
+                    for (unsigned int u = 0; u < k; u++) {
+                        auto w = weight[u * k + j];
+                        if (w >= 0 && mask >> u & 1 && dp[mask * k + u] >= 0 && dp[mask * k + u] + w == value) {
+                            j = u;
+                            break;
+                        }
+                    }
+                }
+                std::reverse(path.nodes.begin(), path.nodes.end());
+                return path;
+            }
+
+            std::span<const unsigned int> nodes;
+            unsigned int k = 0;
+            bool cycle = false;
+            bool large = false;
+            PathSolution inside;                    // Large: the longest path inside the block
+            std::vector<std::uint64_t> lengths;     // Table: lengths[i * k + j] between local nodes i and j, for
+                                                    // large blocks only in the rows of the articulation points
+            std::vector<std::int64_t> weight;       // Table: weight[i * k + j] of the edge between them, -1 for none
+            std::vector<std::uint32_t> order;       // Cycle: the local node at every position along it
+            std::vector<std::uint32_t> position;    // Cycle: the position of every local node
+            std::vector<std::uint64_t> prefix;      // Cycle: length from position 0 to every position
+        };
+
+        // The best path found so far in the block-cut tree DP, and how to put it together.
+        struct Candidate {
+            enum class Shape {
+                Inside,     // Lies within block
+                End,        // Comes up from below cut s and ends inside block
+                Pair,       // Comes up from below cut s, crosses block and goes down below cut t
+                Joint       // Comes up through block, passes cut s and goes down through other
+            };
+            std::uint64_t length = 0;
+            Shape shape = Shape::Inside;
+            std::size_t block = 0;
+            std::size_t other = 0;
+            unsigned int s = 0;
+            unsigned int t = 0;
+        };
+    }
+
+    GraphStructure detectStructure(const Graph & graph) {
+        const unsigned int n = graph.getNodeCount();
+        const auto components = componentCount(graph);
+        if (edgeCount(graph) + components == n) return GraphStructure::Forest;
+
+        bool allTwo = components == 1;
+        for (unsigned int v = 1; v <= n && allTwo; v++) allTwo &= graph.getDegree(v) == 2;
+        if (allTwo) return GraphStructure::Cycle;
+
+        return isSolvable(biconnectedComponents(graph)) ? GraphStructure::BlockTree : GraphStructure::General;
+    }
+
+    PathSolution longestPathForest(const Graph & graph) {
+        const unsigned int n = graph.getNodeCount();
+        if (n == 0) return {};
+        std::vector<std::uint64_t> distance(n + 1, 0);
+        std::vector<unsigned int> parent(n + 1, 0), stack;
+        std::vector<bool> seen(n + 1, false);
+        std::vector<unsigned int> stamp(n + 1, 0);
+        unsigned int pass = 0;
+
+        // Distances from start to everything in its tree, returns the furthest node.
+        auto furthest = [&](unsigned int start) {
+            pass++;
+            distance[start] = 0;
+            parent[start] = 0;
+            stamp[start] = pass;
+            stack = {start};
+            unsigned int best = start;
+            while (!stack.empty()) {
+                auto v = stack.back();
+                stack.pop_back();
+                seen[v] = true;
+                if (distance[v] > distance[best]) best = v;
+                auto neighbours = graph.getNeighbours(v);
+                auto weights = graph.getWeights(v);
+                for (std::size_t k = 0; k < neighbours.size(); k++) {
+                    auto u = neighbours[k];
+                    if (stamp[u] == pass) continue;
+                    stamp[u] = pass;
+                    parent[u] = v;
+                    distance[u] = distance[v] + weights[k];
+                    stack.push_back(u);
+                }
+            }
+            return best;
+        };
+
+        PathSolution best{0, {1}};
+        for (unsigned int root = 1; root <= n; root++) {
+            if (seen[root]) continue;
+            auto a = furthest(root);
+            auto b = furthest(a);
+            if (distance[b] <= best.length) continue;
+            best.length = distance[b];
+            best.nodes.clear();
+            for (auto v = b; v != 0; v = parent[v]) best.nodes.push_back(v);
+        }
+        return best;
+    }
+
+    PathSolution longestPathCycle(const Graph & graph) {
+        if (detectStructure(graph) != GraphStructure::Cycle) throw std::invalid_argument("Graph is not a cycle.");
+        auto blocks = biconnectedComponents(graph);
+        return BlockPaths(blocks.blocks[0], blocks.getEdges(0), {}).path();
+    }
+
+    PathSolution longestPathBlockTree(const Graph & graph, unsigned int threads) {
+        const unsigned int n = graph.getNodeCount();
+        if (n == 0) return {};
+        auto blocks = biconnectedComponents(graph);
+        if (!isSolvable(blocks)) throw std::invalid_argument("Graph has a block that is too large to solve.");
+        auto tree = blockCutTree(blocks);
+        const auto count = blocks.blocks.size();
+
+        std::vector<BlockPaths> paths(count);
+        parallelFor(count, [&](std::size_t b) {
+            paths[b] = BlockPaths(blocks.blocks[b], blocks.getEdges(b), tree.cuts[b]);
+        }, threads);
+
+        // Root every tree at a block and list the blocks top down, each block hangs below parentCut.
+        std::vector<unsigned int> parentCut(count, 0);
+        std::vector<std::size_t> order;
+        std::vector<bool> listed(count, false);
+        order.reserve(count);
+        for (std::size_t root = 0; root < count; root++) {
+            if (listed[root]) continue;
+            listed[root] = true;
+            order.push_back(root);
+            for (auto i = order.size() - 1; i < order.size(); i++) {
+                auto b = order[i];
+                for (auto t : tree.cuts[b]) {
+                    if (t == parentCut[b]) continue;
+                    for (auto child : tree.blocksAt[t]) {
+                        if (listed[child]) continue;
+                        listed[child] = true;
+                        parentCut[child] = t;
+                        order.push_back(child);
+                    }
+                }
+            }
+        }
+
+        // Bottom up. down[t]: best path from cut t into the blocks below it, starting with block bestBelow[t].
+        // blockDown[b]: best path from parentCut[b] into b and below, leaving b through cut blockExit[b] (0 if it
+        // ends inside b).
+        std::vector<std::uint64_t> down(n + 1, 0), blockDown(count, 0);
+        std::vector<std::size_t> bestBelow(n + 1, noBlock);
+        std::vector<unsigned int> blockExit(count, 0);
+        std::vector<std::pair<unsigned int, std::uint64_t>> ends;
+        Candidate best{paths[0].full(), Candidate::Shape::Inside, 0};
+        auto offer = [&](const Candidate & candidate) {
+            if (candidate.length > best.length) best = candidate;
+        };
+        for (auto i = order.rbegin(); i != order.rend(); i++) {
+            const auto b = *i;
+            const auto p = parentCut[b];
+            const auto & block = paths[b];
+            offer({block.full(), Candidate::Shape::Inside, b});
+            ends.clear();
+            for (auto t : tree.cuts[b]) {
+                if (t == p) continue;
+                // The two best blocks below t, a path may come up through one and go down through the other.
+                std::size_t first = noBlock, second = noBlock;
+                for (auto child : tree.blocksAt[t]) {
+                    if (child == b) continue;
+                    if (first == noBlock || blockDown[child] > blockDown[first]) {
+                        second = first;
+                        first = child;
+                    } else if (second == noBlock || blockDown[child] > blockDown[second]) {
+                        second = child;
+                    }
+                }
+                if (first != noBlock && blockDown[first] > 0) {
+                    down[t] = blockDown[first];
+                    bestBelow[t] = first;
+                }
+                if (second != noBlock)
+                    offer({blockDown[first] + blockDown[second], Candidate::Shape::Joint, first, second, t});
+                offer({down[t] + block.from(t), Candidate::Shape::End, b, 0, t});
+                ends.emplace_back(t, down[t]);
+            }
+            auto pair = block.bestPair(ends);
+            offer({pair.length, Candidate::Shape::Pair, b, 0, pair.s, pair.t});
+            if (p == 0) continue;
+            blockDown[b] = block.from(p);
+            for (auto [t, below] : ends) {
+                if (block.between(p, t) + below > blockDown[b]) {
+                    blockDown[b] = block.between(p, t) + below;
+                    blockExit[b] = t;
+                }
+            }
+        }
+
+        // Paths down from a cut or block, built iteratively since the tree can be as deep as the graph is long.
+        auto downFrom = [&](unsigned int t, std::size_t b) {
+            PathSolution path{0, {t}};
+            while (b != noBlock) {
+                auto exit = blockExit[b];
+                extend(path, paths[b].path(t, exit));
+                if (exit == 0) break;
+                t = exit;
+                b = bestBelow[t];
+            }
+            return path;
+        };
+
+        switch (best.shape) {
+            case Candidate::Shape::Inside:
+                return paths[best.block].path();
+            case Candidate::Shape::End: {
+                auto path = reversed(downFrom(best.s, bestBelow[best.s]));
+                extend(path, paths[best.block].path(best.s));
+                return path;
+            }
+            case Candidate::Shape::Pair: {
+                auto path = reversed(downFrom(best.s, bestBelow[best.s]));
+                extend(path, paths[best.block].path(best.s, best.t));
+                extend(path, downFrom(best.t, bestBelow[best.t]));
+                return path;
+            }
+            default: {
+                auto path = reversed(downFrom(best.s, best.block));
+                extend(path, downFrom(best.s, best.other));
+                return path;
+            }
+        }
+    }
+
+    std::optional<PathSolution> longestPathStructured(const Graph & graph, unsigned int threads) {
+        switch (detectStructure(graph)) {
+            case GraphStructure::Forest: return longestPathForest(graph);
+            case GraphStructure::Cycle: return longestPathCycle(graph);
+            case GraphStructure::BlockTree: return longestPathBlockTree(graph, threads);
+            default: return std::nullopt;
+        }
+    }
+}
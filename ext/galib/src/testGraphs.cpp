@@ -5,13 +5,14 @@
 #include <stdexcept>
 #include "../include/testGraphs.h"
 #include "../include/randomGraph.h"
+#include "../include/benchmarkGraphs.h"
 
 namespace graph_lib {
-    std::vector<std::vector<unsigned int>> simpleConnComp(unsigned int param = 7){
+    EdgeList simpleConnComp(unsigned int param = 7){
         if (param != 7)
             throw std::invalid_argument("Param needs to be exactly 7 to ensure correct graph generation.");
 
-        std::vector<std::vector<unsigned int>> testData = std::vector<std::vector<unsigned int>>();
+        EdgeList testData = EdgeList();
         testData.push_back({1, 5, 3});
         testData.push_back({2, 4, 1});
         testData.push_back({3, 4, 5});
@@ -20,11 +21,11 @@ namespace graph_lib {
         return testData;
     }
 
-    std::vector<std::vector<unsigned int>> exampleGraph(unsigned int param = 9){
+    EdgeList exampleGraph(unsigned int param = 9){
         if (param != 9)
             throw std::invalid_argument("Param needs to be exactly 9 to ensure correct graph generation.");
 
-        std::vector<std::vector<unsigned int>> testData = std::vector<std::vector<unsigned int>>();
+        EdgeList testData = EdgeList();
         testData.push_back({1, 2, 3});
         testData.push_back({1, 4, 2});
         testData.push_back({1, 9, 4});
@@ -39,11 +40,11 @@ namespace graph_lib {
     }
 
 
-    std::vector<std::vector<unsigned int>> ringGraphTricky(unsigned int  param) {
+    EdgeList ringGraphTricky(unsigned int  param) {
         if (param < 3)
             throw std::invalid_argument("Param needs to be at least 3 to ensure a cycle.");
 
-        std::vector<std::vector<unsigned int>> testData = std::vector<std::vector<unsigned int>>();
+        EdgeList testData = EdgeList();
         unsigned int ringlength = param;
         testData.push_back({1, ringlength, 1});
         // makes links between n and n+1 for all 1-ringlength(inclusive) and 1 ringlength.
@@ -53,11 +54,11 @@ namespace graph_lib {
         return testData;
     }
 
-    std::vector<std::vector<unsigned int>> ringGraphAscending(unsigned int  param) {
+    EdgeList ringGraphAscending(unsigned int  param) {
         if (param < 3)
             throw std::invalid_argument("Param needs to be at least 3 to ensure a cycle.");
 
-        std::vector<std::vector<unsigned int>> testData = std::vector<std::vector<unsigned int>>();
+        EdgeList testData = EdgeList();
         unsigned int ringlength = param;
         testData.push_back({1, ringlength, 1});
         // makes links between n and n+1 for all 1-ringlength(inclusive) and 1 ringlength.
@@ -67,11 +68,11 @@ namespace graph_lib {
         return testData;
     }
 
-    std::vector<std::vector<unsigned int>> kiteGraph(unsigned int  param) {
+    EdgeList kiteGraph(unsigned int  param) {
         if (param < 3 && param % 3 != 1)
             throw std::invalid_argument("Param needs to be at least 4, and a value like 3*k+1");
 
-        std::vector<std::vector<unsigned int>> testData = std::vector<std::vector<unsigned int>>();
+        EdgeList testData = EdgeList();
         // make little diamonds linked along one corner each.
         for (unsigned int  i = 0; i < param/3; i++){
             testData.push_back({3*i+1, 3*i+2, 3});
@@ -82,12 +83,12 @@ namespace graph_lib {
         return testData;
     }
 
-    std::vector<std::vector<unsigned int>> antiLoop(unsigned int param) {
+    EdgeList antiLoop(unsigned int param) {
         if (param < 4)
             throw std::invalid_argument("Param needs to be at least 4 to ensure non-zero positive weights.");
 
         unsigned int nodes = param -1;
-        std::vector<std::vector<unsigned int>> testData = std::vector<std::vector<unsigned int>>();
+        EdgeList testData = EdgeList();
         testData.push_back({1, 2, 5 * nodes});
         testData.push_back({2, nodes, nodes - 3});
         for (unsigned int i = 2; i < nodes; i++){
@@ -98,7 +99,7 @@ namespace graph_lib {
     }
 
     Graph getGraphByType(int i, int param, double param2, int seed){
-        std::vector<std::vector<unsigned int>> input;
+        EdgeList input;
         switch (i){
             case 0: return erdosGraphRecursive(param, param2, seed);
             case 1: return erdosGraphRejection(param, param2, seed);
@@ -107,6 +108,9 @@ namespace graph_lib {
             case 4: input = ringGraphAscending(param); break;
             case 5: input = kiteGraph(param); break;
             case 6: input = antiLoop(param); break;
+            case 7: input = erdosInputGenSkip(param, param2, seed); break;
+            case 8: return erdosGraphConnected(param, param2, seed);
+            case 9: case 10: case 11: case 12: case 13: input = benchmarkGraphEdges(i, param, param2, seed); break;
         }
         return Graph(input, param);
     }
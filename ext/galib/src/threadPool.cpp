@@ -0,0 +1,117 @@
+//
+// Created on 18/10/2026.
+//
+#include <utility>
+#include "../include/threadPool.h"
+#include "../include/parallel.h"
+
+namespace graph_lib {
+    namespace {
+        // The pool and worker index the calling thread belongs to, currentPool is null outside any pool.
+        thread_local const WorkStealingPool * currentPool = nullptr;
+        thread_local unsigned int currentWorker = 0;
+    }
+
+    WorkStealingPool::WorkStealingPool(unsigned int threadCount) {
+        if (threadCount == 0) threadCount = defaultThreadCount();
+        for (unsigned int i = 0; i < threadCount; i++) workers.push_back(std::make_unique<Worker>());
+        for (unsigned int i = 0; i < threadCount; i++) threads.emplace_back(&WorkStealingPool::run, this, i);
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto & thread : threads) thread.join();
+    }
+
+    void WorkStealingPool::submit(std::function<void()> task) {
+        // Workers push onto their own deque, everybody else spreads tasks round robin.
+        auto index = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+        pending++;
+        // Counted before the task is visible, so a worker taking it right away never decrements queued below 0.
+        queued++;
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            workers[index]->tasks.push_back(std::move(task));
+        }
+        {
+            // Taking the lock orders this with a worker that is about to sleep, so the wake up is not lost.
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wakeUp.notify_one();
+    }
+
+    bool WorkStealingPool::tryTake(unsigned int index, std::function<void()> & task) {
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            if (!workers[index]->tasks.empty()) {
+                task = std::move(workers[index]->tasks.back());
+                workers[index]->tasks.pop_back();
+                queued--;
+                return true;
+            }
+        }
+        for (std::size_t offset = 1; offset < workers.size(); offset++) {
+            auto & victim = *workers[(index + offset) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::run(unsigned int index) {
+        currentPool = this;
+        currentWorker = index;
+        std::function<void()> task;
+        while (true) {
+            if (tryTake(index, task)) {
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                    if (!failure) failure = std::current_exception();
+                }
+                task = nullptr;
+                if (--pending == 0) {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                    allDone.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            idle++;
+            wakeUp.wait(lock, [this] { return stopping || queued > 0; });
+            idle--;
+            if (stopping) return;
+        }
+    }
+
+    void WorkStealingPool::wait() {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        allDone.wait(lock, [this] { return pending == 0; });
+        if (failure) std::rethrow_exception(std::exchange(failure, nullptr));
+    }
+
+    bool WorkStealingPool::waitFor(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (!allDone.wait_for(lock, timeout, [this] { return pending == 0; })) return false;
+        if (failure) std::rethrow_exception(std::exchange(failure, nullptr));
+        return true;
+    }
+
+    unsigned int WorkStealingPool::getThreadCount() const {
+        return workers.size();
+    }
+
+    unsigned int WorkStealingPool::getIdleCount() const {
+        return idle;
+    }
+}